@@ -15,6 +15,17 @@
 #include <Arduino.h>
 #include "Line.h"
 #include "mozzi_fixmath.h"
+#include "mozzi_pgmspace.h"
+#include "tables/expcurve257_uint16.h"
+
+
+/** The shapes an ADSR segment can take on the way to its level, set with ADSR::setAttackShape() and the like.
+*/
+enum adsr_shapes {
+	ADSR_LINEAR, /**< a straight line, the default */
+	ADSR_EXPONENTIAL, /**< quick at first, slowing down as it nears the level, like an analogue envelope: natural for plucked and percussive decays and releases */
+	ADSR_LOGARITHMIC /**< the reverse, slow at first and speeding up, for swells */
+};
 
 
 /** A simple ADSR envelope generator.  This implementation has separate update() and next()
@@ -33,6 +44,10 @@ LERP_RATE could be set to MOZZI_CONTROL_RATE (for instance).  Then update() and
 greatly reducing the amount of processing required compared to calling next() in updateAudio().
 @todo Test whether using the template parameters makes any difference to speed,
 and rationalise which units do and don't need them.
+
+Each segment can be a straight line, or exponential or logarithmic, using a shared table, EXPCURVE257_DATA.
+A straight segment costs one addition per next(), and a curved one two table reads and two multiplies.
+next() gives an 8 bit level, and next16() a 16 bit one, which moves smoothly enough to shape 16 bit audio without steps.
 Template objects are messy when you try to use pointers to them,
 you have to include the whole template in the pointer handling.
 */
@@ -55,6 +70,7 @@ private:
 		T update_steps;
 		long lerp_steps; // signed, to match params to transition (line) type Q15n16, below
 		Q8n0 level;
+		byte shape;
 	}attack,decay,sustain,release,idle;
 
 	phase * current_phase;
@@ -62,6 +78,10 @@ private:
 	// Linear audio rate transitions for envelope
 	//Line <unsigned long> transition;
 	Line <Q15n16> transition; // scale up unsigned char levels for better accuracy, then scale down again for output
+	// in curved phases, transition goes from 0 to CURVE_END instead, and chooses where to read the curve
+	static const Q15n16 CURVE_END = 1L << 24;
+	Q15n16 level; // the last output, where the next phase starts from
+	int32_t curve_start, curve_span; // the start of a curved phase, and how far it goes, as Q8n8
 
 	inline
 	T convertMsecToControlUpdateSteps(unsigned int msec){
@@ -73,7 +93,13 @@ private:
 	void setPhase(phase * next_phase) {
 		update_step_counter = 0;
 		num_update_steps = next_phase->update_steps;
-		transition.set(Q8n0_to_Q15n16(next_phase->level),next_phase->lerp_steps);
+		if (next_phase->shape == ADSR_LINEAR) {
+			transition.set(level, Q8n0_to_Q15n16(next_phase->level), next_phase->lerp_steps);
+		} else {
+			curve_start = level >> 8;
+			curve_span = ((int32_t) next_phase->level << 8) - curve_start;
+			transition.set(0, CURVE_END, next_phase->lerp_steps);
+		}
 		current_phase = next_phase;
 	}
 
@@ -103,6 +129,23 @@ private:
 	}
 
 
+	// the level for a position in a curved phase, from 0 to CURVE_END
+	inline
+	Q15n16 curveLevel(Q15n16 position)
+	{
+		if (position > CURVE_END) position = CURVE_END;
+		bool logarithmic = (current_phase->shape == ADSR_LOGARITHMIC);
+		// the logarithmic curve is the exponential one turned around
+		uint32_t x = logarithmic ? CURVE_END - position : position;
+		uint16_t index = x >> 16;
+		uint8_t fraction = (uint8_t) (x >> 8);
+		uint16_t a = FLASH_OR_RAM_READ<const uint16_t>(EXPCURVE257_DATA + index);
+		uint16_t c = (index < 256) ? a + (uint16_t) (((uint32_t) (FLASH_OR_RAM_READ<const uint16_t>(EXPCURVE257_DATA + index + 1) - a) * fraction) >> 8) : a;
+		if (logarithmic) c = 32768 - c;
+		return (curve_start + ((curve_span * c) >> 15)) << 8;
+	}
+
+
 
 public:
 
@@ -116,6 +159,8 @@ public:
 		release.phase_type = RELEASE;
 		idle.phase_type = IDLE;
 		release.level = 0;
+		attack.shape = decay.shape = sustain.shape = release.shape = idle.shape = ADSR_LINEAR;
+		level = 0;
 		adsr_playing = false;
 		current_phase = &idle;
 	}
@@ -161,7 +206,21 @@ public:
 	unsigned char next()
 	{
 		unsigned char out = 0;
-		if (adsr_playing) out = Q15n16_to_Q8n0(transition.next());
+		if (adsr_playing) out = Q15n16_to_Q8n0(nextLevel());
+		return out;
+	}
+
+
+
+	/** Advances one audio step along the ADSR and returns the level with 16 bits of resolution.
+	Call this in updateAudio() instead of next(), for envelopes on 16 bit signals.
+	@return the next value, as a Q8n8 number from 0 to 65280, which is a level of 255.
+	 */
+	inline
+	uint16_t next16()
+	{
+		uint16_t out = 0;
+		if (adsr_playing) out = (uint16_t) (nextLevel() >> 8);
 		return out;
 	}
 
@@ -174,7 +233,7 @@ public:
 	*/
 	inline
 	void noteOn(bool reset=false){
-		if (reset) transition.set(0);
+		if (reset) level = 0;
 		setPhase(&attack);
 		adsr_playing = true;
 	}
@@ -273,6 +332,63 @@ public:
 	}
 
 
+	/** Set the shape of the attack.
+	@param shape ADSR_LINEAR, ADSR_EXPONENTIAL or ADSR_LOGARITHMIC.
+	Exponential attacks rise quickly and round off into the decay, like an analogue envelope.
+	 */
+	inline
+	void setAttackShape(byte shape)
+	{
+		attack.shape = shape;
+	}
+
+
+	/** Set the shape of the decay.
+	@param shape ADSR_LINEAR, ADSR_EXPONENTIAL or ADSR_LOGARITHMIC.
+	 */
+	inline
+	void setDecayShape(byte shape)
+	{
+		decay.shape = shape;
+	}
+
+
+	/** Set the shape of the sustain, if it moves from the decay level to a different sustain level.
+	@param shape ADSR_LINEAR, ADSR_EXPONENTIAL or ADSR_LOGARITHMIC.
+	 */
+	inline
+	void setSustainShape(byte shape)
+	{
+		sustain.shape = shape;
+	}
+
+
+	/** Set the shape of the release.
+	@param shape ADSR_LINEAR, ADSR_EXPONENTIAL or ADSR_LOGARITHMIC.
+	 */
+	inline
+	void setReleaseShape(byte shape)
+	{
+		release.shape = shape;
+	}
+
+
+	/** Set the shapes of the attack, decay, sustain and release.
+	@param attack the attack shape, ADSR_LINEAR, ADSR_EXPONENTIAL or ADSR_LOGARITHMIC.
+	@param decay the decay shape.
+	@param sustain the sustain shape.
+	@param release the release shape.
+	 */
+	inline
+	void setShapes(byte attack, byte decay, byte sustain, byte release)
+	{
+		setAttackShape(attack);
+		setDecayShape(decay);
+		setSustainShape(sustain);
+		setReleaseShape(release);
+	}
+
+
 	/** Set the attack time of the ADSR in milliseconds.
 	The actual time taken will be resolved within the resolution of MOZZI_CONTROL_RATE.
 	@param msec the unsigned int attack time in milliseconds.
@@ -420,6 +536,19 @@ public:
 
 bool adsr_playing;
 
+private:
+
+	// the next level, as Q15n16, along a straight line or a curve
+	inline
+	Q15n16 nextLevel()
+	{
+		Q15n16 position = transition.next();
+		level = (current_phase->shape == ADSR_LINEAR) ? position : curveLevel(position);
+		return level;
+	}
+
+public:
+
 	/** Tells if the envelope is currently playing.
 	@return true if playing, false if in IDLE state
 	*/
@@ -437,4 +566,8 @@ bool adsr_playing;
 This is an example of how to use the ADSR class.
 */
 
+/** @example 07.Envelopes/ADSR_Curved_Envelope/ADSR_Curved_Envelope.ino
+This is an example of how to use the ADSR class with curved segments.
+*/
+
 #endif /* ADSR_H_ */
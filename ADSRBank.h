@@ -0,0 +1,247 @@
+/*
+ * ADSRBank.h
+ *
+ * This file is part of Mozzi.
+ *
+ * Copyright 2012-2024 Tim Barrass and the Mozzi Team
+ *
+ * Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+ *
+ */
+
+#ifndef ADSRBANK_H_
+#define ADSRBANK_H_
+
+#include <Arduino.h>
+#include "mozzi_fixmath.h"
+
+
+/** A bank of ADSR envelopes for polyphonic sketches, which runs many voices more cheaply than separate ADSRs.
+The state of each voice is kept in arrays, one for each field, rather than an object for each voice,
+and the levels and times are kept in a few sets of settings which voices share, so update() only looks at
+each voice's phase and step counter until one of them reaches the end of a phase,
+and next() moves every voice along its straight line in one pass, with no branches.
+
+Like ADSR, update() goes in updateControl() and next() in updateAudio(), and the envelopes go through
+attack, decay, sustain and release, each a straight line to its level, taking the time set for it,
+unless noteOff() starts the release early.  Voices which have finished their release stay at 0.
+
+@tparam NUM_VOICES how many envelopes there are.
+@tparam CONTROL_UPDATE_RATE how often update() is called, usually MOZZI_CONTROL_RATE.
+@tparam LERP_RATE how often next() is called, usually MOZZI_AUDIO_RATE.
+@tparam NUM_SETTINGS how many sets of levels and times there are for the voices to choose from.
+*/
+template <uint8_t NUM_VOICES, unsigned int CONTROL_UPDATE_RATE, unsigned int LERP_RATE, uint8_t NUM_SETTINGS = 1>
+class ADSRBank
+{
+
+public:
+	/** Constructor.  All the voices start idle, and all the settings at 0.
+	*/
+	ADSRBank()
+	{
+		for (uint8_t v = 0; v < NUM_VOICES; ++v)
+		{
+			phase[v] = IDLE;
+			settings[v] = 0;
+			counter[v] = 0;
+			value[v] = step[v] = 0;
+		}
+		for (uint8_t s = 0; s < NUM_SETTINGS; ++s)
+		{
+			for (uint8_t p = 0; p < IDLE; ++p)
+			{
+				levels[s][p] = 0;
+				update_steps[s][p] = 0;
+			}
+		}
+	}
+
+
+	/** Set the levels of a set of settings.
+	@param attack the attack level.
+	@param decay the decay level.
+	@param sustain the sustain level, usually the same as the decay level.
+	@param release the release level, usually 0.
+	@param settings_index which set of settings, from 0 to NUM_SETTINGS-1.
+	*/
+	void setLevels(byte attack, byte decay, byte sustain, byte release, uint8_t settings_index = 0)
+	{
+		levels[settings_index][ATTACK] = attack;
+		levels[settings_index][DECAY] = decay;
+		levels[settings_index][SUSTAIN] = sustain;
+		levels[settings_index][RELEASE] = release;
+	}
+
+
+	/** Set the attack and decay levels of a set of settings, with the sustain at the decay level and the release to 0.
+	@param attack the attack level.
+	@param decay the decay and sustain level.
+	@param settings_index which set of settings, from 0 to NUM_SETTINGS-1.
+	*/
+	void setADLevels(byte attack, byte decay, uint8_t settings_index = 0)
+	{
+		setLevels(attack, decay, decay, 0, settings_index);
+	}
+
+
+	/** Set the times of a set of settings, in milliseconds.
+	The actual times will be resolved within the resolution of CONTROL_UPDATE_RATE.
+	@param attack_ms the attack time.
+	@param decay_ms the decay time.
+	@param sustain_ms the sustain time, after which the release starts even without a noteOff().
+	@param release_ms the release time.
+	@param settings_index which set of settings, from 0 to NUM_SETTINGS-1.
+	*/
+	void setTimes(unsigned int attack_ms, unsigned int decay_ms, unsigned int sustain_ms, unsigned int release_ms, uint8_t settings_index = 0)
+	{
+		update_steps[settings_index][ATTACK] = convertMsecToControlUpdateSteps(attack_ms);
+		update_steps[settings_index][DECAY] = convertMsecToControlUpdateSteps(decay_ms);
+		update_steps[settings_index][SUSTAIN] = convertMsecToControlUpdateSteps(sustain_ms);
+		update_steps[settings_index][RELEASE] = convertMsecToControlUpdateSteps(release_ms);
+	}
+
+
+	/** Start the attack of a voice.  This restarts it whatever phase it is in.
+	@param voice which voice, from 0 to NUM_VOICES-1.
+	@param settings_index which set of settings the voice uses until its next noteOn().
+	@param reset If true, the envelope starts from 0, otherwise it rises from its current level.
+	*/
+	void noteOn(uint8_t voice, uint8_t settings_index = 0, bool reset = false)
+	{
+		settings[voice] = settings_index;
+		if (reset) value[voice] = 0;
+		setPhase(voice, ATTACK);
+	}
+
+
+	/** Start the release of a voice.
+	@param voice which voice, from 0 to NUM_VOICES-1.
+	*/
+	void noteOff(uint8_t voice)
+	{
+		if (phase[voice] != IDLE) setPhase(voice, RELEASE);
+	}
+
+
+	/** Updates the phases of all the voices.  Call this in updateControl(), or at CONTROL_UPDATE_RATE.
+	*/
+	void update()
+	{
+		for (uint8_t v = 0; v < NUM_VOICES; ++v)
+		{
+			uint8_t p = phase[v];
+			if (p != IDLE && ++counter[v] >= update_steps[settings[v]][p]) setPhase(v, p + 1);
+		}
+	}
+
+
+	/** Advances every voice one step along its envelope.  Call this in updateAudio(), or at LERP_RATE,
+	and then read each voice's level with level().
+	*/
+	inline
+	void next()
+	{
+		for (uint8_t v = 0; v < NUM_VOICES; ++v) value[v] += step[v];
+	}
+
+
+	/** The level of a voice, as it was at the last next().
+	@param voice which voice, from 0 to NUM_VOICES-1.
+	@return the level, from 0 to 255.
+	*/
+	inline
+	unsigned char level(uint8_t voice)
+	{
+		return Q15n16_to_Q8n0(value[voice]);
+	}
+
+
+	/** The level of a voice with 16 bits of resolution, as it was at the last next().
+	@param voice which voice, from 0 to NUM_VOICES-1.
+	@return the level, as a Q8n8 number from 0 to 65280, which is a level of 255.
+	*/
+	inline
+	uint16_t level16(uint8_t voice)
+	{
+		return (uint16_t) (value[voice] >> 8);
+	}
+
+
+	/** Tells if a voice's envelope is playing.
+	@param voice which voice, from 0 to NUM_VOICES-1.
+	@return true if the voice is playing, false if it's idle.
+	*/
+	inline
+	bool playing(uint8_t voice)
+	{
+		return phase[voice] != IDLE;
+	}
+
+
+	/** Find a voice to play a new note on.
+	@return the first idle voice, or -1 if they're all playing.
+	*/
+	int8_t idleVoice()
+	{
+		for (uint8_t v = 0; v < NUM_VOICES; ++v)
+		{
+			if (phase[v] == IDLE) return v;
+		}
+		return -1;
+	}
+
+
+private:
+	enum {ATTACK, DECAY, SUSTAIN, RELEASE, IDLE};
+	static const unsigned int LERPS_PER_CONTROL = LERP_RATE / CONTROL_UPDATE_RATE;
+
+	// the state of each voice
+	uint8_t phase[NUM_VOICES];
+	uint8_t settings[NUM_VOICES];
+	uint16_t counter[NUM_VOICES];
+	Q15n16 value[NUM_VOICES];
+	Q15n16 step[NUM_VOICES];
+
+	// the shared settings, for each phase but IDLE
+	Q8n0 levels[NUM_SETTINGS][IDLE];
+	uint16_t update_steps[NUM_SETTINGS][IDLE];
+
+
+	inline
+	uint16_t convertMsecToControlUpdateSteps(unsigned int msec)
+	{
+		return (uint16_t) (((uint32_t) msec * CONTROL_UPDATE_RATE) >> 10); // approximate /1000 with shift
+	}
+
+
+	// start a phase, with a line from the voice's level to the phase's level
+	void setPhase(uint8_t voice, uint8_t next_phase)
+	{
+		phase[voice] = next_phase;
+		counter[voice] = 0;
+		if (next_phase == IDLE)
+		{
+			value[voice] = step[voice] = 0;
+			return;
+		}
+		uint8_t s = settings[voice];
+		Q15n16 target = Q8n0_to_Q15n16(levels[s][next_phase]);
+		long lerp_steps = (long) update_steps[s][next_phase] * LERPS_PER_CONTROL;
+		if (lerp_steps)
+		{
+			step[voice] = (target - value[voice]) / lerp_steps;
+		}
+		else
+		{
+			value[voice] = target;
+			step[voice] = 0;
+		}
+	}
+};
+
+/** @example 07.Envelopes/ADSR_Bank/ADSR_Bank.ino
+This is an example of how to use the ADSRBank class.
+*/
+
+#endif /* ADSRBANK_H_ */
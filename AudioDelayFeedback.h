@@ -43,7 +43,7 @@ class AudioDelayFeedback
 public:
 	/** Constructor.
 	*/
-	AudioDelayFeedback(): write_pos(0), _feedback_level(0), _delaytime_cells(0)
+	AudioDelayFeedback(): write_pos(0), _feedback_level(0), _delaytime_cells(0), _coeff(0), last_in(0), last_out(0)
 	{}
 
 
@@ -52,7 +52,7 @@ public:
 	For example, 128 cells delay at MOZZI_AUDIO_RATE 16384 would produce a time delay of 128/16384 = 0.0078125 s = 7.8 ms
 	Put another way, num_cells = delay_seconds * MOZZI_AUDIO_RATE.
 	*/
-	AudioDelayFeedback(uint16_t delaytime_cells): write_pos(0), _feedback_level(0), _delaytime_cells(delaytime_cells)
+	AudioDelayFeedback(uint16_t delaytime_cells): write_pos(0), _feedback_level(0), _delaytime_cells(delaytime_cells), _coeff(0), last_in(0), last_out(0)
 	{}
 
 
@@ -62,7 +62,7 @@ public:
 	Put another way, num_cells = delay_seconds * MOZZI_AUDIO_RATE.
 	@param feedback_level is the feedback level from -128 to 127 (representing -1 to 1).
 	*/
-	AudioDelayFeedback(uint16_t delaytime_cells, int8_t feedback_level): write_pos(0),  _feedback_level(feedback_level), _delaytime_cells(delaytime_cells)
+	AudioDelayFeedback(uint16_t delaytime_cells, int8_t feedback_level): write_pos(0),  _feedback_level(feedback_level), _delaytime_cells(delaytime_cells), _coeff(0), last_in(0), last_out(0)
 	{}
 
 
@@ -82,6 +82,21 @@ public:
 
 
 
+	/** Process a block of samples through the delay, at the stored delay time, with feedback.
+	This gives the same result as calling next(su input) for each sample in turn, but the
+	delay's state is held in local variables for the whole block, so it can stay in registers.
+	@param input an array of num_samples input values.
+	@param output an array to receive num_samples delayed values.  It can't be the same array as input.
+	@param num_samples how many samples to process.
+	*/
+	inline
+	void next(const su * input, return_type * output, uint16_t num_samples)
+	{
+		next(input, output, num_samples, Int2Type<INTERP_TYPE>());
+	}
+
+
+
 	/**  Input a value to the delay, retrieve the signal in the delay line at the position delaytime_cells, and add feedback from the output to the input.
 	@param input the signal input.
 	@param delaytime_cells indicates the delay time in terms of cells in the delay buffer.
@@ -255,8 +270,8 @@ private:
 	int8_t _feedback_level;
 	uint16_t _delaytime_cells;
 	Q15n16 _coeff; // for allpass interpolation
-        su last_in;
-        return_type last_out;
+	su last_in; // allpass interpolator state, kept per instance so several delays don't interfere
+	return_type last_out;
 
 
 
@@ -300,12 +315,6 @@ private:
 		= coeff * (in-last_out) + last_in
 		*/
 		//setPin13High();
-
-	  /* I think these should **not** be static 
-		static int8_t last_in;
-		static int16_t last_out;
-	  */
-	  
 		++write_pos &= (NUM_BUFFER_SAMPLES - 1);
 
 		uint16_t read_pos1 = (write_pos - _delaytime_cells) & (NUM_BUFFER_SAMPLES - 1);
@@ -327,6 +336,51 @@ private:
 
 
 
+	inline
+	void next(const su * input, return_type * output, uint16_t num_samples, Int2Type<LINEAR>)
+	{
+		uint16_t wpos = write_pos;
+		const uint16_t delaytime = _delaytime_cells;
+		const int8_t feedback_level = _feedback_level;
+		for (uint16_t i = 0; i < num_samples; ++i)
+		{
+			++wpos &= (NUM_BUFFER_SAMPLES - 1);
+			return_type delay_sig = delay_array[(wpos - delaytime) & (NUM_BUFFER_SAMPLES - 1)];
+			su feedback_sig = (su) constrain(((delay_sig * feedback_level)>>7), -(1<<((sizeof(su)<<3)-1)), (1<<((sizeof(su)<<3)-1))-1);
+			delay_array[wpos] = (return_type) input[i] + feedback_sig;
+			output[i] = delay_sig;
+		}
+		write_pos = wpos;
+	}
+
+
+	inline
+	void next(const su * input, return_type * output, uint16_t num_samples, Int2Type<ALLPASS>)
+	{
+		uint16_t wpos = write_pos;
+		const uint16_t delaytime = _delaytime_cells;
+		const int8_t feedback_level = _feedback_level;
+		const Q15n16 coeff = _coeff;
+		su in_z = last_in;
+		return_type out_z = last_out;
+		for (uint16_t i = 0; i < num_samples; ++i)
+		{
+			++wpos &= (NUM_BUFFER_SAMPLES - 1);
+			return_type delay_sig = delay_array[(wpos - delaytime) & (NUM_BUFFER_SAMPLES - 1)];
+			su in = input[i];
+			delay_sig += (return_type)(coeff * ((return_type)in - out_z)>>(sizeof(su)<<4)) + in_z;
+			su feedback_sig = (su) constrain(((delay_sig * feedback_level)>>7), -(1<<((sizeof(su)<<3)-1)), (1<<((sizeof(su)<<3)-1))-1);
+			delay_array[wpos] = (return_type) in + feedback_sig;
+			in_z = in;
+			out_z = delay_sig;
+			output[i] = delay_sig;
+		}
+		write_pos = wpos;
+		last_in = in_z;
+		last_out = out_z;
+	}
+
+
 	// 20-25us
 	inline
 	void setDelayTimeCells(Q16n16 delaytime_cells, Int2Type<ALLPASS>)
@@ -0,0 +1,621 @@
+/*
+ * BiquadFilter.h
+ *
+ * This file is part of Mozzi.
+ *
+ * Copyright 2012-2024 Tim Barrass and the Mozzi Team
+ *
+ * Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+ *
+ */
+
+#ifndef BIQUADFILTER_H_
+#define BIQUADFILTER_H_
+
+#include <Arduino.h>
+#include "MozziHeadersOnly.h"
+#include "mozzi_fixmath.h"
+#include "meta.h"
+#include "ResonantFilter.h" // for Q1n15_filterCoeffFromHz()
+
+/*
+Biquad designs from Robert Bristow-Johnson's Audio EQ Cookbook,
+https://www.w3.org/TR/audio-eq-cookbook/
+
+for each sample, in direct form 1...
+y = b0*x + b1*x1 + b2*x2 - a1*y1 - a2*y2
+x2 = x1; x1 = x; y2 = y1; y1 = y;
+
+At low cutoffs the poles are very close to 1, where a1 is nearly -2 and a2 nearly 1, and what sets the filter
+is how far they are from those: 1 + a1 + a2 is only about 0.00001 for a 20Hz lowpass at 32768Hz.
+The zeros of notches, peaks and shelves are just as close, with b1 nearly -2*b0 and b2 nearly b0.
+So the coefficients are kept as their differences from those,
+c1 = b1 + 2*b0, c2 = b2 - b0, d1 = a1 + 2, d2 = a2 - 1, and
+y = b0*(x - 2*x1 + x2) + c1*x1 + c2*x2 + 2*y1 - y2 - d1*y1 - d2*y2
+Each section stores d1 and d2 with as many fractional bits as fit them in 15 bits, up to 28, then c1 and c2, and then b0,
+each with as many as fit them, up to the number before, so each term is still a 16x16 bit multiply into a 32 bit sum.
+c2 is rounded so that c1 + c2 matches the rounded d1 + d2 times the gain at DC, which keeps that gain
+what it should be, exactly 1 for a lowpass however low it is.  The bits of each sum below 16 bits are carried into the next,
+and what's left from the last is added in to the next sample (error feedback), so the rounding doesn't build up in the tail.
+
+The design functions only use arithmetic and their own series for sin, cos and exp,
+so they are constexpr: with constant arguments the coefficients are worked out
+when compiling, with no floats left in the sketch.  lowpassHz() and highpassHz() are made
+with integers and a table instead, for filters which change while the sketch runs.
+*/
+
+
+/** The coefficients for one section of a BiquadFilter, with functions to design the common filter types.
+The design functions can be used at compile time, for example
+@code
+constexpr BiquadCoeffs bass_boost = BiquadCoeffs::lowShelf(200, 0.7f, 6);
+@endcode
+or when the sketch is running, where they cost a few dozen float operations, so they're best called in updateControl() only when the settings change.
+lowpassHz() and highpassHz() don't use floats, so they are quick enough for sweeping a filter in updateControl().
+*/
+struct BiquadCoeffs
+{
+	int16_t b0; // with b_bits fractional bits
+	int16_t c1, c2; // b1 + 2*b0 and b2 - b0, with c_bits fractional bits
+	int16_t d1, d2; // a1 + 2 and a2 - 1, with a_bits fractional bits
+	uint8_t b_bits, c_bits, a_bits;
+
+	/** Constructor, for setting raw coefficients directly.  Normally the design functions are used instead.
+	The defaults pass the signal through unchanged.
+	@param _b0 b0, with _b_bits fractional bits.
+	@param _c1,_c2 b1 + 2*b0 and b2 - b0, with _c_bits fractional bits.
+	@param _d1,_d2 a1 + 2 and a2 - 1, with _a_bits fractional bits.
+	@param _b_bits,_c_bits,_a_bits the numbers of fractional bits, each no more than the next, up to 28.
+	All five coefficients have to be between -16384 and 16383.
+	*/
+	constexpr BiquadCoeffs(int16_t _b0 = 1, int16_t _c1 = 2, int16_t _c2 = -1, int16_t _d1 = 2, int16_t _d2 = -1, uint8_t _b_bits = 0, uint8_t _c_bits = 0, uint8_t _a_bits = 0):
+		b0(_b0), c1(_c1), c2(_c2), d1(_d1), d2(_d2), b_bits(_b_bits), c_bits(_c_bits), a_bits(_a_bits) {}
+
+
+	/** 2-pole lowpass.
+	@param freq the cutoff frequency in Hz, below half the sample rate.
+	@param q the resonance, 0.7071 for a maximally flat (Butterworth) response.
+	@param rate the sample rate the filter will run at.
+	*/
+	static constexpr BiquadCoeffs lowpass(float freq, float q, float rate = MOZZI_AUDIO_RATE)
+	{
+		return lowpassOA(oneMinusCosine(omega(freq, rate)), alpha(omega(freq, rate), q));
+	}
+
+
+	/** 2-pole highpass.
+	@param freq the cutoff frequency in Hz, below half the sample rate.
+	@param q the resonance, 0.7071 for a maximally flat (Butterworth) response.
+	@param rate the sample rate the filter will run at.
+	*/
+	static constexpr BiquadCoeffs highpass(float freq, float q, float rate = MOZZI_AUDIO_RATE)
+	{
+		return highpassOA(oneMinusCosine(omega(freq, rate)), alpha(omega(freq, rate), q));
+	}
+
+
+	/** 2-pole bandpass, with a gain of 1 at the centre frequency.
+	@param freq the centre frequency in Hz, below half the sample rate.
+	@param q the sharpness, the centre frequency divided by the bandwidth.
+	@param rate the sample rate the filter will run at.
+	*/
+	static constexpr BiquadCoeffs bandpass(float freq, float q, float rate = MOZZI_AUDIO_RATE)
+	{
+		return bandpassOA(oneMinusCosine(omega(freq, rate)), alpha(omega(freq, rate), q));
+	}
+
+
+	/** Notch, removing a narrow band around one frequency.
+	@param freq the centre frequency in Hz, below half the sample rate.
+	@param q the sharpness, the centre frequency divided by the bandwidth.
+	@param rate the sample rate the filter will run at.
+	*/
+	static constexpr BiquadCoeffs notch(float freq, float q, float rate = MOZZI_AUDIO_RATE)
+	{
+		return notchOA(oneMinusCosine(omega(freq, rate)), alpha(omega(freq, rate), q));
+	}
+
+
+	/** Peaking EQ, boosting or cutting a band around one frequency.
+	@param freq the centre frequency in Hz, below half the sample rate.
+	@param q the sharpness, the centre frequency divided by the bandwidth.
+	@param gain_db how much to boost (positive) or cut (negative) in decibels, up to 18.
+	@param rate the sample rate the filter will run at.
+	*/
+	static constexpr BiquadCoeffs peaking(float freq, float q, float gain_db, float rate = MOZZI_AUDIO_RATE)
+	{
+		return peakingAOA(amplitude(gain_db), oneMinusCosine(omega(freq, rate)), alpha(omega(freq, rate), q));
+	}
+
+
+	/** Low shelf EQ, boosting or cutting everything below a frequency.
+	@param freq the corner frequency in Hz, below half the sample rate.
+	@param q the steepness of the shelf, 0.7071 for the steepest without a bump.
+	@param gain_db how much to boost (positive) or cut (negative) in decibels, up to 18.
+	@param rate the sample rate the filter will run at.
+	*/
+	static constexpr BiquadCoeffs lowShelf(float freq, float q, float gain_db, float rate = MOZZI_AUDIO_RATE)
+	{
+		return shelfAOA(amplitude(gain_db), oneMinusCosine(omega(freq, rate)), alpha(omega(freq, rate), q), 1.f);
+	}
+
+
+	/** High shelf EQ, boosting or cutting everything above a frequency.
+	@param freq the corner frequency in Hz, below half the sample rate.
+	@param q the steepness of the shelf, 0.7071 for the steepest without a bump.
+	@param gain_db how much to boost (positive) or cut (negative) in decibels, up to 18.
+	@param rate the sample rate the filter will run at.
+	*/
+	static constexpr BiquadCoeffs highShelf(float freq, float q, float gain_db, float rate = MOZZI_AUDIO_RATE)
+	{
+		return shelfAOA(amplitude(gain_db), oneMinusCosine(omega(freq, rate)), alpha(omega(freq, rate), q), -1.f);
+	}
+
+
+	/** The q of one section of a Butterworth filter made of 2-pole sections.
+	@param order the order of the whole filter, twice the number of sections.
+	@param section which section, from 0 to order/2 - 1.
+	@return the q to use with lowpass() or highpass() for that section.
+	*/
+	static constexpr float butterworthQ(uint8_t order, uint8_t section)
+	{
+		return 0.5f / cosine(PI_F * (2 * section + 1) / (2.f * order));
+	}
+
+
+	/** 2-pole lowpass at MOZZI_AUDIO_RATE, made with integer arithmetic and a table instead of floats, so it's quick enough
+	to call in updateControl() for filter sweeps.  The cutoff comes from the same table as ResonantFilter::setCutoffHz(),
+	so the cutoff is a little less exact than lowpass() gives at the lowest frequencies, within about 1% at 20Hz, though the gain at DC is still exactly 1.
+	@param freq the cutoff frequency in Hz, up to MOZZI_AUDIO_RATE/4.
+	@param q the resonance, a Q8n8 number from 128 (0.5) up, 181 for a maximally flat (Butterworth) response.
+	*/
+	static BiquadCoeffs lowpassHz(uint16_t freq, Q8n8 q)
+	{
+		return fromHz(freq, q, false);
+	}
+
+
+	/** 2-pole highpass at MOZZI_AUDIO_RATE, made with integer arithmetic and a table instead of floats, see lowpassHz().
+	@param freq the cutoff frequency in Hz, up to MOZZI_AUDIO_RATE/4.
+	@param q the resonance, a Q8n8 number from 128 (0.5) up, 181 for a maximally flat (Butterworth) response.
+	*/
+	static BiquadCoeffs highpassHz(uint16_t freq, Q8n8 q)
+	{
+		return fromHz(freq, q, true);
+	}
+
+
+private:
+	static constexpr float PI_F = 3.14159265f;
+	static const uint8_t MAX_BITS = 28;
+
+	static constexpr float omega(float freq, float rate)
+	{
+		return 2.f * PI_F * freq / rate;
+	}
+
+	// series for sin(x) with x in -pi/2 to pi/2
+	static constexpr float sineSeries(float x, float x2)
+	{
+		return x * (1.f - x2 / 6.f * (1.f - x2 / 20.f * (1.f - x2 / 42.f * (1.f - x2 / 72.f * (1.f - x2 / 110.f * (1.f - x2 / 156.f))))));
+	}
+
+	// sin(x) for x in 0 to pi
+	static constexpr float sine(float x)
+	{
+		return (x > PI_F / 2) ? sineSeries(PI_F - x, (PI_F - x) * (PI_F - x)) : sineSeries(x, x * x);
+	}
+
+	// cos(x) for x in 0 to pi
+	static constexpr float cosine(float x)
+	{
+		return sineSeries(PI_F / 2 - x, (PI_F / 2 - x) * (PI_F / 2 - x));
+	}
+
+	// 1 - cos(x), as 2 sin^2(x/2), which keeps its precision when x is small
+	static constexpr float oneMinusCosine(float x)
+	{
+		return 2.f * square(sine(x * 0.5f));
+	}
+
+	static constexpr float alpha(float w, float q)
+	{
+		return sine(w) / (2.f * q);
+	}
+
+	static constexpr float square(float x)
+	{
+		return x * x;
+	}
+
+	// e^x, halving x until the series is accurate and squaring back up
+	static constexpr float exponential(float x)
+	{
+		return (x > 0.5f || x < -0.5f) ? square(exponential(x * 0.5f)) :
+		       1.f + x * (1.f + x / 2.f * (1.f + x / 3.f * (1.f + x / 4.f * (1.f + x / 5.f * (1.f + x / 6.f)))));
+	}
+
+	// 10^(gain_db/40), the cookbook's A
+	static constexpr float amplitude(float gain_db)
+	{
+		return exponential(gain_db * (2.30258509f / 40.f));
+	}
+
+	static constexpr float absolute(float x)
+	{
+		return x < 0 ? -x : x;
+	}
+
+	static constexpr float larger(float a, float b)
+	{
+		return (absolute(a) > absolute(b)) ? absolute(a) : absolute(b);
+	}
+
+	// how many fractional bits x can have and still round to less than 16384, up to bits
+	static constexpr uint8_t fractionalBits(float x, uint8_t bits = MAX_BITS)
+	{
+		return (bits > 0 && absolute(x) * (float) (1UL << bits) >= 16383.5f) ? fractionalBits(x, bits - 1) : bits;
+	}
+
+	static constexpr int32_t toFixed(float x, uint8_t bits)
+	{
+		return (int32_t) (x * (float) (1UL << bits) + ((x < 0) ? -0.5f : 0.5f));
+	}
+
+	// with c2 rounded so c1 + c2 is the gain at DC times the rounded d1 + d2, or 0 when the gain at DC is 0
+	static constexpr BiquadCoeffs quantiseC(float b0, int16_t c1, float dc_gain, int16_t d1, int16_t d2, uint8_t b_bits, uint8_t c_bits, uint8_t a_bits)
+	{
+		return BiquadCoeffs(toFixed(b0, b_bits), c1, toFixed(dc_gain * (d1 + d2) / (float) (1UL << (a_bits - c_bits)), 0) - c1,
+		                    d1, d2, b_bits, c_bits, a_bits);
+	}
+
+	static constexpr BiquadCoeffs quantiseB(float b0, float c1, float dc_gain, float d1, float d2, uint8_t c_bits, uint8_t a_bits)
+	{
+		return quantiseC(b0, toFixed(c1, c_bits), dc_gain, toFixed(d1, a_bits), toFixed(d2, a_bits), fractionalBits(b0, c_bits), c_bits, a_bits);
+	}
+
+	static constexpr BiquadCoeffs quantise(float b0, float c1, float c2, float dc_gain, float d1, float d2, uint8_t a_bits)
+	{
+		return quantiseB(b0, c1, dc_gain, d1, d2, fractionalBits(larger(c1, c2), a_bits), a_bits);
+	}
+
+	// from b0, c1 = b1 + 2*b0, c2 = b2 - b0, a0, d1 = a1 + 2*a0 and d2 = a2 - a0, before dividing by a0,
+	// with the sums c1 + c2 and d1 + d2 worked out without cancelling
+	static constexpr BiquadCoeffs normalise(float b0, float c1, float c2, float c_sum, float a0, float d1, float d2, float d_sum)
+	{
+		return quantise(b0 / a0, c1 / a0, c2 / a0, (c_sum == 0.f) ? 0.f : c_sum / d_sum, d1 / a0, d2 / a0,
+		                fractionalBits(larger(d1, d2) / a0));
+	}
+
+	// the designs from om = 1 - cos(w) and al = alpha, with the poles of the lowpass, highpass, bandpass and notch
+	static constexpr BiquadCoeffs polesOA(float b0, float c1, float c2, float c_sum, float om, float al)
+	{
+		return normalise(b0, c1, c2, c_sum, 1.f + al, 2.f * om + 2.f * al, -2.f * al, 2.f * om);
+	}
+
+	static constexpr BiquadCoeffs lowpassOA(float om, float al)
+	{
+		return polesOA(om / 2.f, 2.f * om, 0.f, 2.f * om, om, al);
+	}
+
+	static constexpr BiquadCoeffs highpassOA(float om, float al)
+	{
+		return polesOA((2.f - om) / 2.f, 0.f, 0.f, 0.f, om, al);
+	}
+
+	static constexpr BiquadCoeffs bandpassOA(float om, float al)
+	{
+		return polesOA(al, 2.f * al, -2.f * al, 0.f, om, al);
+	}
+
+	static constexpr BiquadCoeffs notchOA(float om, float al)
+	{
+		return polesOA(1.f, 2.f * om, 0.f, 2.f * om, om, al);
+	}
+
+	static constexpr BiquadCoeffs peakingAOA(float A, float om, float al)
+	{
+		return normalise(1.f + al * A, 2.f * om + 2.f * al * A, -2.f * al * A, 2.f * om,
+		                 1.f + al / A, 2.f * om + 2.f * al / A, -2.f * al / A, 2.f * om);
+	}
+
+	// low shelf with sign 1, high shelf with sign -1
+	static constexpr BiquadCoeffs shelfAOA(float A, float om, float al, float sign)
+	{
+		return shelfTerms(A, om, sign * (1.f - om), 2.f * squareRoot(A) * al, (A + 1.f) + sign * (A - 1.f), (A + 1.f) - sign * (A - 1.f));
+	}
+
+	// by Newton's method, for A between about 0.1 and 10
+	static constexpr float squareRoot(float A, float guess = 1.f, uint8_t iterations = 6)
+	{
+		return iterations ? squareRoot(A, 0.5f * (guess + A / guess), iterations - 1) : guess;
+	}
+
+	// scs is sign * cos(w), beta is 2 sqrt(A) alpha, and zeros and poles are (A + 1) +- sign (A - 1), which scale om in the sums
+	static constexpr BiquadCoeffs shelfTerms(float A, float om, float scs, float beta, float zeros, float poles)
+	{
+		return normalise(A * ((A + 1.f) - (A - 1.f) * scs + beta), 2.f * A * (om * zeros + beta), -2.f * A * beta, 2.f * A * om * zeros,
+		                 (A + 1.f) + (A - 1.f) * scs + beta, 2.f * om * poles + 2.f * beta, -2.f * beta, 2.f * om * poles);
+	}
+
+	// x / a0, from x as a Q29 number and 1/a0 as Q16, without a 64 bit multiply
+	static inline
+	uint32_t overA0(uint32_t x, uint32_t reciprocal)
+	{
+		return (x >> 16) * reciprocal + (((x & 0xFFFF) * reciprocal) >> 16);
+	}
+
+	// a Q29 number with bits fractional bits, rounded
+	static inline
+	uint32_t fromQ29(uint32_t x, uint8_t bits)
+	{
+		return (x + (1UL << (28 - bits))) >> (29 - bits);
+	}
+
+	// the lowpass and highpass designs in integers, from k = 2 sin(w/2), which the table gives, with 1 - cos(w) = k^2 / 2
+	// and sin(w) = k sqrt(1 - k^2 / 4), worked out as Q29 numbers and divided by a0 by multiplying with its reciprocal
+	static BiquadCoeffs fromHz(uint16_t freq, Q8n8 q, bool high)
+	{
+		uint32_t k = Q1n15_filterCoeffFromHz(freq);
+		uint32_t k_squared = k * k; // Q2n30, up to 2 at MOZZI_AUDIO_RATE/4
+		uint32_t sin_w = (k * isqrt32((1UL << 30) - (k_squared >> 2))) >> 15; // Q1n15
+		if (q < 128) q = 128;
+		uint32_t al = (sin_w << 7) / q; // alpha, Q1n15, up to 1
+		uint32_t reciprocal = (1UL << 31) / (32768 + al);
+		uint32_t d_sum = overA0(k_squared >> 1, reciprocal); // d1 + d2 = 2 (1 - cos(w)) / a0
+		uint32_t minus_d2 = overA0(al << 15, reciprocal); // 2 alpha / a0
+		uint8_t a_bits = MAX_BITS;
+		while (fromQ29(d_sum, a_bits) + fromQ29(minus_d2, a_bits) >= 16384) --a_bits;
+		int16_t d2 = -(int16_t) fromQ29(minus_d2, a_bits);
+		int16_t dc = fromQ29(d_sum, a_bits);
+		if (high)
+		{
+			uint32_t b0 = overA0((1UL << 29) - (k_squared >> 3), reciprocal); // (1 + cos(w)) / 2 a0
+			uint8_t b_bits = a_bits;
+			while (fromQ29(b0, b_bits) >= 16384) --b_bits;
+			return BiquadCoeffs(fromQ29(b0, b_bits), 0, 0, dc - d2, d2, b_bits, b_bits, a_bits);
+		}
+		// c1 + c2 is d1 + d2, so the gain at DC is exactly 1
+		return BiquadCoeffs(fromQ29(overA0(k_squared >> 3, reciprocal), a_bits), dc, 0, dc - d2, d2, a_bits, a_bits, a_bits);
+	}
+};
+
+
+// a 20Hz lowpass at 32768Hz has tiny coefficients, which still have to give a gain of exactly 1 at DC
+static_assert(BiquadCoeffs::lowpass(20, 0.7071f, 32768).c_bits == BiquadCoeffs::lowpass(20, 0.7071f, 32768).a_bits &&
+              BiquadCoeffs::lowpass(20, 0.7071f, 32768).c1 + BiquadCoeffs::lowpass(20, 0.7071f, 32768).c2 ==
+              BiquadCoeffs::lowpass(20, 0.7071f, 32768).d1 + BiquadCoeffs::lowpass(20, 0.7071f, 32768).d2 &&
+              BiquadCoeffs::lowpass(20, 0.7071f, 32768).d1 + BiquadCoeffs::lowpass(20, 0.7071f, 32768).d2 > 0 &&
+              BiquadCoeffs::lowpass(20, 0.7071f, 32768).b0 > 0, "BiquadCoeffs::lowpass() must have a gain of 1 at DC");
+
+
+/** A cascade of biquad (2-pole, 2-zero) filter sections, for EQs, shelving, steep lowpass and highpass filters and crossovers.
+Each section has its own coefficients (see BiquadCoeffs) and state.  The sections are processed in series.
+
+The input and output are 16 bit signed, though the input should be kept to 15 bits (-16384 to 16383) to leave room for the
+filter's internal sums.  Resonant or boosting sections are clipped at 16 bits.
+
+@tparam NUM_SECTIONS how many 2-pole sections, 1 by default.  Each adds 2 to the order of the filter.
+*/
+template <uint8_t NUM_SECTIONS = 1>
+class BiquadFilter
+{
+
+public:
+	/** Constructor.  All the sections start as passing the signal through unchanged.
+	*/
+	BiquadFilter()
+	{
+		reset();
+	}
+
+
+	/** Set the coefficients of one section.
+	@param section which section, from 0 to NUM_SECTIONS-1.
+	@param coeffs the coefficients, from one of the BiquadCoeffs design functions.
+	*/
+	inline
+	void setSection(uint8_t section, const BiquadCoeffs & coeffs)
+	{
+		c[section] = coeffs;
+	}
+
+
+	/** Set the same coefficients for every section, for example to make a steeper filter from several identical ones.
+	@param coeffs the coefficients, from one of the BiquadCoeffs design functions.
+	*/
+	inline
+	void setAllSections(const BiquadCoeffs & coeffs)
+	{
+		for (uint8_t i = 0; i < NUM_SECTIONS; ++i) c[i] = coeffs;
+	}
+
+
+	/** Make the cascade a Butterworth lowpass of order 2*NUM_SECTIONS, which has the flattest passband for its steepness.
+	This uses floats, so call it only when the frequency changes.
+	@param freq the cutoff frequency in Hz.
+	*/
+	void setButterworthLowpass(float freq)
+	{
+		for (uint8_t i = 0; i < NUM_SECTIONS; ++i) c[i] = BiquadCoeffs::lowpass(freq, BiquadCoeffs::butterworthQ(2 * NUM_SECTIONS, i));
+	}
+
+
+	/** Make the cascade a Butterworth highpass of order 2*NUM_SECTIONS.
+	This uses floats, so call it only when the frequency changes.
+	@param freq the cutoff frequency in Hz.
+	*/
+	void setButterworthHighpass(float freq)
+	{
+		for (uint8_t i = 0; i < NUM_SECTIONS; ++i) c[i] = BiquadCoeffs::highpass(freq, BiquadCoeffs::butterworthQ(2 * NUM_SECTIONS, i));
+	}
+
+
+	/** Make the cascade a Linkwitz-Riley lowpass of order 2*NUM_SECTIONS, which is two Butterworth filters of half the order in series.
+	Together with setLinkwitzRileyHighpass() on another filter at the same frequency, it makes a crossover whose two outputs add back up to a flat response.
+	NUM_SECTIONS must be even.  This uses floats, so call it only when the frequency changes.
+	@param freq the crossover frequency in Hz.
+	*/
+	void setLinkwitzRileyLowpass(float freq)
+	{
+		static_assert(NUM_SECTIONS % 2 == 0, "Linkwitz-Riley filters need an even number of sections");
+		for (uint8_t i = 0; i < NUM_SECTIONS; ++i) c[i] = BiquadCoeffs::lowpass(freq, BiquadCoeffs::butterworthQ(NUM_SECTIONS, i >> 1));
+	}
+
+
+	/** Make the cascade a Linkwitz-Riley highpass of order 2*NUM_SECTIONS.
+	The lowpass and highpass outputs are in phase, so adding them gives back the whole signal.
+	NUM_SECTIONS must be even.  This uses floats, so call it only when the frequency changes.
+	@param freq the crossover frequency in Hz.
+	*/
+	void setLinkwitzRileyHighpass(float freq)
+	{
+		static_assert(NUM_SECTIONS % 2 == 0, "Linkwitz-Riley filters need an even number of sections");
+		for (uint8_t i = 0; i < NUM_SECTIONS; ++i) c[i] = BiquadCoeffs::highpass(freq, BiquadCoeffs::butterworthQ(NUM_SECTIONS, i >> 1));
+	}
+
+
+	/** Make the cascade a Butterworth lowpass of order 2*NUM_SECTIONS at MOZZI_AUDIO_RATE, like setButterworthLowpass(),
+	but with integer arithmetic (see BiquadCoeffs::lowpassHz()), so it's quick enough to sweep the cutoff in updateControl().
+	@param freq the cutoff frequency in Hz, up to MOZZI_AUDIO_RATE/4.
+	*/
+	void setButterworthLowpassHz(uint16_t freq)
+	{
+		setSectionsHz<false>(freq, false, Int2Type<NUM_SECTIONS>());
+	}
+
+
+	/** Make the cascade a Butterworth highpass of order 2*NUM_SECTIONS at MOZZI_AUDIO_RATE, like setButterworthHighpass(),
+	but with integer arithmetic, so it's quick enough to sweep the cutoff in updateControl().
+	@param freq the cutoff frequency in Hz, up to MOZZI_AUDIO_RATE/4.
+	*/
+	void setButterworthHighpassHz(uint16_t freq)
+	{
+		setSectionsHz<false>(freq, true, Int2Type<NUM_SECTIONS>());
+	}
+
+
+	/** Make the cascade a Linkwitz-Riley lowpass of order 2*NUM_SECTIONS at MOZZI_AUDIO_RATE, like setLinkwitzRileyLowpass(),
+	but with integer arithmetic, so it's quick enough to move the crossover in updateControl().
+	NUM_SECTIONS must be even.
+	@param freq the crossover frequency in Hz, up to MOZZI_AUDIO_RATE/4.
+	*/
+	void setLinkwitzRileyLowpassHz(uint16_t freq)
+	{
+		static_assert(NUM_SECTIONS % 2 == 0, "Linkwitz-Riley filters need an even number of sections");
+		setSectionsHz<true>(freq, false, Int2Type<NUM_SECTIONS>());
+	}
+
+
+	/** Make the cascade a Linkwitz-Riley highpass of order 2*NUM_SECTIONS at MOZZI_AUDIO_RATE, like setLinkwitzRileyHighpass(),
+	but with integer arithmetic, so it's quick enough to move the crossover in updateControl().
+	NUM_SECTIONS must be even.
+	@param freq the crossover frequency in Hz, up to MOZZI_AUDIO_RATE/4.
+	*/
+	void setLinkwitzRileyHighpassHz(uint16_t freq)
+	{
+		static_assert(NUM_SECTIONS % 2 == 0, "Linkwitz-Riley filters need an even number of sections");
+		setSectionsHz<true>(freq, true, Int2Type<NUM_SECTIONS>());
+	}
+
+
+	/** Clear the filter's memory of previous samples, for example to silence a ringing resonance.
+	*/
+	void reset()
+	{
+		for (uint8_t i = 0; i < NUM_SECTIONS; ++i)
+		{
+			x1[i] = x2[i] = y1[i] = y2[i] = 0;
+			error[i] = 0;
+		}
+	}
+
+
+	/** Filter the next sample.
+	@param in the input sample, up to 15 bits.
+	@return the filtered sample.
+	*/
+	inline
+	int next(int in)
+	{
+		int16_t x = in;
+		for (uint8_t i = 0; i < NUM_SECTIONS; ++i)
+		{
+			x = step(c[i], x, x1[i], x2[i], y1[i], y2[i], error[i]);
+		}
+		return x;
+	}
+
+
+	/** Filter a block of samples, with the same result as calling next() on each one.
+	@param input the input samples, up to 15 bits.
+	@param output where to write the filtered samples, which can be the same as input.
+	@param num_samples how many samples to process.
+	*/
+	void next(const int * input, int * output, uint16_t num_samples)
+	{
+		if (input != output) for (uint16_t n = 0; n < num_samples; ++n) output[n] = input[n];
+		// one section at a time over the whole block, so each section's state stays in registers
+		for (uint8_t i = 0; i < NUM_SECTIONS; ++i)
+		{
+			const BiquadCoeffs coeffs = c[i];
+			int16_t sx1 = x1[i], sx2 = x2[i], sy1 = y1[i], sy2 = y2[i];
+			int32_t err = error[i];
+			for (uint16_t n = 0; n < num_samples; ++n)
+			{
+				output[n] = step(coeffs, output[n], sx1, sx2, sy1, sy2, err);
+			}
+			x1[i] = sx1; x2[i] = sx2; y1[i] = sy1; y2[i] = sy2;
+			error[i] = err;
+		}
+	}
+
+
+private:
+	BiquadCoeffs c[NUM_SECTIONS];
+	int16_t x1[NUM_SECTIONS], x2[NUM_SECTIONS], y1[NUM_SECTIONS], y2[NUM_SECTIONS];
+	int32_t error[NUM_SECTIONS]; // bits lost in the last shift, added back next sample
+
+	// one sample through one section, with the fractional bits of the b0 term carried into the c sum, and those of the c sum
+	// into the d sum, so all that's lost is the part of the d sum below a_bits, which goes into err for next time
+	static inline
+	int16_t step(const BiquadCoeffs & k, int16_t x, int16_t & x1, int16_t & x2, int16_t & y1, int16_t & y2, int32_t & err)
+	{
+		int32_t b_sum = (int32_t) k.b0 * ((int32_t) x - 2 * (int32_t) x1 + x2);
+		int32_t c_sum = (int32_t) k.c1 * x1 + (int32_t) k.c2 * x2 + ((b_sum & ((1L << k.b_bits) - 1)) << (k.c_bits - k.b_bits));
+		int32_t feedback = err - (int32_t) k.d1 * y1 - (int32_t) k.d2 * y2 + ((c_sum & ((1L << k.c_bits) - 1)) << (k.a_bits - k.c_bits));
+		int32_t sum = 2 * (int32_t) y1 - y2 + (b_sum >> k.b_bits) + (c_sum >> k.c_bits) + (feedback >> k.a_bits);
+		err = feedback & ((1L << k.a_bits) - 1);
+		int16_t y = (int16_t) constrain(sum, -32768L, 32767L);
+		x2 = x1;
+		x1 = x;
+		y2 = y1;
+		y1 = y;
+		return y;
+	}
+
+	// set each section, with its Butterworth q worked out when compiling, and the sections in pairs with the same q for Linkwitz-Riley
+	template <bool LINKWITZ_RILEY, int SECTIONS>
+	void setSectionsHz(uint16_t freq, bool high, Int2Type<SECTIONS>)
+	{
+		setSectionsHz<LINKWITZ_RILEY>(freq, high, Int2Type<SECTIONS - 1>());
+		constexpr Q8n8 q = butterworthQ8n8<LINKWITZ_RILEY ? NUM_SECTIONS : 2 * NUM_SECTIONS, LINKWITZ_RILEY ? (SECTIONS - 1) / 2 : SECTIONS - 1>();
+		c[SECTIONS - 1] = high ? BiquadCoeffs::highpassHz(freq, q) : BiquadCoeffs::lowpassHz(freq, q);
+	}
+
+	template <bool LINKWITZ_RILEY>
+	void setSectionsHz(uint16_t, bool, Int2Type<0>) {}
+
+	template <uint8_t ORDER, uint8_t SECTION>
+	static constexpr Q8n8 butterworthQ8n8()
+	{
+		return (Q8n8) (BiquadCoeffs::butterworthQ(ORDER, SECTION) * 256.f + 0.5f);
+	}
+};
+
+/**
+@example 10.Audio_Filters/BiquadFilter/BiquadFilter.ino
+This example demonstrates the BiquadFilter class.
+*/
+
+#endif /* BIQUADFILTER_H_ */
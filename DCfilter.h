@@ -12,6 +12,8 @@
 #ifndef DCFILTER_H
 #define DCFILTER_H
 
+#include "Arduino.h"
+
 /*
 tb2010 adapted from:
 robert bristow-johnson, DSP Trick: Fixed-Point DC Blocking Filter with Noise-Shaping
@@ -76,14 +78,108 @@ how long it takes to settle to 0 if the input signal levels out at a constant va
 		return prev_y;
 	}
 
+
+	/**
+	Filter a block of samples, with the same result as calling next() on each one,
+	but with the filter's state kept in local variables for the whole block.
+	@param input the samples to filter.
+	@param output where to write the filtered samples, which can be the same as input.
+	@param num_samples how many samples to filter.
+	*/
+	void next(const int * input, int * output, uint16_t num_samples)
+	{
+		long a = acc;
+		int px = prev_x, py = prev_y;
+		const long coeff = A;
+		for (uint16_t n = 0; n < num_samples; ++n)
+		{
+			int x = input[n];
+			a += ((long)(x-px)<<16)>>1;
+			px = x;
+			a -= coeff*py;
+			py = (a>>16)<<1;
+			if (a & 32784) py += 1;
+			output[n] = py;
+		}
+		acc = a;
+		prev_x = px;
+		prev_y = py;
+	}
+
 private:
 	long acc;
 	int prev_x, prev_y,A;
 };
 
+
+
+/**
+A cheap DC-blocking filter for 8 bit unsigned input, like getAudioInput<8>() or mozziAnalogRead<8>(),
+which takes away the offset at mid-scale, or wherever the signal is centred, and outputs a signal centred on 0.
+It subtracts a running average of the input, kept with shifts and adds in 16 bits, so
+unlike DCfilter it needs no multiplies and no 32 bit arithmetic.
+
+y[n] = x[n] - avg[n],  avg[n] = avg[n-1] + (x[n] - avg[n-1]) / 2^SHIFT
+
+@tparam SHIFT sets how slowly the average follows the input, from 1 to 8.  The cutoff frequency is about
+rate / (2 * pi * 2^SHIFT), so at MOZZI_AUDIO_RATE 16384, the default of 7 blocks frequencies below about 20 Hz,
+and 8 below about 10 Hz.
+*/
+template <uint8_t SHIFT = 7>
+class DCblocker8
+{
+
+	static_assert(SHIFT >= 1 && SHIFT <= 8, "DCblocker8's SHIFT must be from 1 to 8");
+
+public:
+	/** Constructor.  The average starts at mid-scale, 128, so a signal centred there needs no time to settle.
+	*/
+	DCblocker8(): acc(128U << SHIFT)
+	{;}
+
+
+	/** Filter the incoming value and return the result.
+	@param x the value to filter, from 0 to 255.
+	@return the filtered signal, centred on 0, from -255 to 255 (-128 to 127 once settled for a signal centred at 128).
+	*/
+	inline
+	int next(uint8_t x)
+	{
+		int y = x - (int) (acc >> SHIFT);
+		acc += y; // acc is the average << SHIFT
+		return y;
+	}
+
+
+	/** Filter a block of samples, with the same result as calling next() on each one.
+	@param input the samples to filter, from 0 to 255.
+	@param output where to write the filtered samples.
+	@param num_samples how many samples to filter.
+	*/
+	void next(const uint8_t * input, int * output, uint16_t num_samples)
+	{
+		uint16_t a = acc;
+		for (uint16_t n = 0; n < num_samples; ++n)
+		{
+			int y = input[n] - (int) (a >> SHIFT);
+			a += y;
+			output[n] = y;
+		}
+		acc = a;
+	}
+
+private:
+	uint16_t acc;
+};
+
 /**
 @example 05.Control_Filters/DCFilter/DCFilter.ino
 This example demonstrates the DCFilter class.
 */
 
+/**
+@example 04.Audio_Input/Audio_Input_DC_Blocked/Audio_Input_DC_Blocked.ino
+This example demonstrates the DCblocker8 class.
+*/
+
 #endif        //  #ifndef DCFILTER_H
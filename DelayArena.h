@@ -0,0 +1,182 @@
+/*
+ * DelayArena.h
+ *
+ * This file is part of Mozzi.
+ *
+ * Copyright 2012-2024 Tim Barrass and the Mozzi Team
+ *
+ * Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+ *
+ */
+
+#ifndef DELAYARENA_H_
+#define DELAYARENA_H_
+
+#include <Arduino.h>
+#include <string.h>
+#include "mozzi_fixmath.h"
+
+
+/** A single block of delay memory shared by several delay lines of any length.
+AudioDelay and AudioDelayFeedback each need their own power-of-two array, so a sketch with an echo,
+a doubler and a comb filter wastes the RAM between each delay time and the next power of two.
+DelayArena instead carves up to MAX_LINES lines out of one buffer of NUM_CELLS cells, each exactly as long as it needs to be,
+and the lines can be made longer or shorter while the sketch runs as long as they all still fit.
+
+Because the lengths aren't powers of two, the lines wrap around with a compare instead of a mask,
+which costs about the same.  Lines are referred to by the number addLine() returns.
+Each line can be used as a plain delay with next(), or with write() and any number of read()s or readInterpolated()s at different delay times.
+
+@tparam NUM_CELLS the total number of cells shared by all the lines.
+@tparam MAX_LINES the most lines the arena can hold, 4 by default.
+@tparam T the type of numbers to use for the signal in the delays.  The default is int8_t, int16_t could be useful on boards with more RAM.
+*/
+template <uint16_t NUM_CELLS, uint8_t MAX_LINES = 4, class T = int8_t>
+class DelayArena
+{
+
+public:
+
+	/** Constructor.
+	*/
+	DelayArena(): num_lines(0)
+	{
+		memset(delay_array, 0, sizeof(delay_array));
+	}
+
+
+	/** Add a delay line at the end of the arena.
+	@param num_cells the length of the line, which is also its longest delay.
+	@return the number of the new line to use with the other functions, or -1 if there's not enough room or already MAX_LINES lines.
+	*/
+	int8_t addLine(uint16_t num_cells)
+	{
+		if (num_lines == MAX_LINES || num_cells == 0 || num_cells > freeCells()) return -1;
+		offset_cells[num_lines] = usedCells();
+		length_cells[num_lines] = num_cells;
+		write_pos[num_lines] = 0;
+		return num_lines++;
+	}
+
+
+	/** Change the length of a line, moving the lines after it along the arena to make room or close the gap.
+	The line which changes length is cleared, the others keep their contents.
+	This moves memory around, so call it only when the length really changes, not every control update.
+	@param line the line to change.
+	@param num_cells the new length.
+	@return true if the line was resized, false if there wasn't enough room in the arena.
+	*/
+	bool setLength(uint8_t line, uint16_t num_cells)
+	{
+		if (num_cells == 0 || (num_cells > length_cells[line] && (num_cells - length_cells[line]) > freeCells())) return false;
+		uint16_t old_end = offset_cells[line] + length_cells[line];
+		uint16_t new_end = offset_cells[line] + num_cells;
+		memmove(delay_array + new_end, delay_array + old_end, (usedCells() - old_end) * sizeof(T));
+		for (uint8_t i = line + 1; i < num_lines; ++i) offset_cells[i] += new_end - old_end; // wraps correctly for shrinking too
+		length_cells[line] = num_cells;
+		write_pos[line] = 0;
+		memset(delay_array + offset_cells[line], 0, num_cells * sizeof(T));
+		return true;
+	}
+
+
+	/** Get the length of a line.
+	@param line which line.
+	@return its length in cells.
+	*/
+	inline
+	uint16_t getLength(uint8_t line)
+	{
+		return length_cells[line];
+	}
+
+
+	/** How much of the arena isn't used by any line.
+	@return the number of free cells.
+	*/
+	inline
+	uint16_t freeCells()
+	{
+		return NUM_CELLS - usedCells();
+	}
+
+
+	/** Input a value to a line and retrieve the value delayed by the full length of the line.
+	This is the cheapest way to use a line, with no delay time to work out.
+	@param line which line.
+	@param in_value the signal input.
+	@return the signal from the length of the line ago.
+	*/
+	inline
+	T next(uint8_t line, T in_value)
+	{
+		T * cell = delay_array + offset_cells[line] + write_pos[line];
+		T delay_sig = *cell;
+		*cell = in_value;
+		if (++write_pos[line] == length_cells[line]) write_pos[line] = 0;
+		return delay_sig;
+	}
+
+
+	/** Input a value to a line without reading from it, for use with read().
+	@param line which line.
+	@param in_value the signal input.
+	*/
+	inline
+	void write(uint8_t line, T in_value)
+	{
+		delay_array[offset_cells[line] + write_pos[line]] = in_value;
+		if (++write_pos[line] == length_cells[line]) write_pos[line] = 0;
+	}
+
+
+	/** Retrieve the signal in a line at a given delay time.
+	@param line which line.
+	@param delaytime_cells the delay time in cells, from 1 (the last value written) up to the length of the line.
+	@return the delayed signal.
+	*/
+	inline
+	T read(uint8_t line, uint16_t delaytime_cells)
+	{
+		uint16_t pos = write_pos[line];
+		if (delaytime_cells > pos) pos += length_cells[line];
+		return delay_array[offset_cells[line] + pos - delaytime_cells];
+	}
+
+
+	/** Retrieve the signal in a line at a fractional delay time, interpolating linearly between cells.
+	@param line which line.
+	@param delaytime_cells the delay time as a Q16n16 number of cells, from 1 up to one less than the length of the line.
+	@return the delayed signal.
+	*/
+	inline
+	T readInterpolated(uint8_t line, Q16n16 delaytime_cells)
+	{
+		uint16_t whole = (uint16_t) (delaytime_cells >> 16);
+		int a = read(line, whole);
+		int b = read(line, (uint16_t) (whole + 1));
+		return (T) (a + (int) (((int32_t) (b - a) * (uint8_t) (delaytime_cells >> 8)) >> 8));
+	}
+
+
+private:
+	T delay_array[NUM_CELLS];
+	uint16_t offset_cells[MAX_LINES];
+	uint16_t length_cells[MAX_LINES];
+	uint16_t write_pos[MAX_LINES];
+	uint8_t num_lines;
+
+
+	inline
+	uint16_t usedCells()
+	{
+		return num_lines ? offset_cells[num_lines - 1] + length_cells[num_lines - 1] : 0;
+	}
+};
+
+/**
+@example 09.Delays/DelayArena/DelayArena.ino
+This example demonstrates the DelayArena class.
+*/
+
+#endif        //  #ifndef DELAYARENA_H_
@@ -18,6 +18,8 @@
 
 #include "math.h"
 #include "mozzi_fixmath.h"
+#include "mozzi_pgmspace.h"
+#include "tables/eadpole256_uint32.h"
 
 
 /** Exponential attack decay envelope. This produces a natural sounding
@@ -45,13 +47,14 @@ public:
 	}
 
 	/** Set the attack time in milliseconds.
+	This uses no floats, so it's quick enough to change the time from a knob every control step.
 	@param attack_ms The time taken for values returned by successive calls of
 	the next() method to change from 0 to 255.
 	*/
 	inline
 	void setAttack(unsigned int attack_ms)
 	{
-		Q8n8attack = float_to_Q8n8(millisToOneMinusRealPole(attack_ms));
+		Q8n8attack = millisToOneMinusRealPole(attack_ms);
 	}
 
 
@@ -62,7 +65,7 @@ public:
 	inline
 	void setDecay(unsigned int decay_ms)
 	{
-		Q8n8decay = float_to_Q8n8(millisToOneMinusRealPole(decay_ms));
+		Q8n8decay = millisToOneMinusRealPole(decay_ms);
 	}
 
 
@@ -139,27 +142,21 @@ private:
 	const unsigned int UPDATE_RATE;
 
 
-	/* convert milliseconds to 1-p, with p a real pole */
+	/* convert milliseconds to 1-p, with p a real pole, as Q8n8.
+	1-p = -expm1(1000 * log(0.001) / (UPDATE_RATE * milliseconds)), which falls as UPDATE_RATE * milliseconds rises,
+	so instead of calculating it, this searches EADPOLE256_DATA for the first Q8n8 value whose threshold has been reached. */
 	inline
-	float millisToOneMinusRealPole(unsigned int milliseconds)
+	Q8n8 millisToOneMinusRealPole(unsigned int milliseconds)
 	{
-		static const float NUMERATOR = 1000.0f * log(0.001f);
-		return  -expm1(NUMERATOR / ((float)UPDATE_RATE * milliseconds));
-	}
-
-
-	// Compute exp(x) - 1 without loss of precision for small values of x.
-	inline
-	float expm1(float x)
-	{
-		if (fabs(x) < 1e-5)
-		{
-			return x + 0.5*x*x;
-		}
-		else
+		uint32_t t = (uint32_t) UPDATE_RATE * milliseconds;
+		if (t == 0) return 256;
+		// thresholds fall as the index rises, so find the first one t reaches, in 8 steps
+		uint8_t lo = 0;
+		for (uint8_t half = 128; half; half >>= 1)
 		{
-			return exp(x) - 1.0;
+			if (t < FLASH_OR_RAM_READ<const uint32_t>(EADPOLE256_DATA + lo + half - 1)) lo += half;
 		}
+		return lo;
 	}
 
 };
@@ -16,6 +16,7 @@
 /** A non-blocking replacement for Arduino's delay() function. 
 EventDelay can be set() to a number of milliseconds, then after calling start(), ready() will return true when the time is up.  
 Alternatively, start(milliseconds) will call set() and start() together.
+For sketches with many delays or metronomes, TimerWheel checks them all with one update().
 */
 class EventDelay
 {
@@ -26,7 +27,7 @@ public:
 	Declare an EventDelay object.
 	@param delay_milliseconds how long until ready() returns true, after calling start().  Defaults to 0 if no parameter is supplied.
 	*/
-	EventDelay(unsigned int delay_milliseconds = 0): AUDIO_TICKS_PER_MILLISECOND((float)MOZZI_AUDIO_RATE/1000.0f)
+	EventDelay(unsigned int delay_milliseconds = 0)
 	{
 		set(delay_milliseconds);
 	}	
@@ -34,12 +35,13 @@ public:
 	
 	/** Set the delay time.  This setting is persistent, until you change it by using set() again.
 	@param delay_milliseconds delay time in milliseconds.
-	@note timing: 12us
+	@note This uses integers, with the whole and fractional parts of the ticks per millisecond worked out at compile time,
+	so it's cheap enough to call every control step.
 	*/
 	inline
 	void set(unsigned int delay_milliseconds)
 	{
-		ticks = (unsigned long)(AUDIO_TICKS_PER_MILLISECOND*delay_milliseconds); // 12us
+		ticks = (unsigned long) delay_milliseconds * TICKS_PER_MILLISECOND + (((unsigned long) delay_milliseconds * TICKS_PER_MILLISECOND_FRACTION) >> 16);
 	}
 
 
@@ -82,7 +84,8 @@ protected:
 	unsigned long ticks;
 	
 private:
-	const float AUDIO_TICKS_PER_MILLISECOND; 
+	static const unsigned int TICKS_PER_MILLISECOND = MOZZI_AUDIO_RATE / 1000;
+	static const unsigned int TICKS_PER_MILLISECOND_FRACTION = ((MOZZI_AUDIO_RATE % 1000) * 65536UL + 500) / 1000; // Q0n16
 };
 
 /**
@@ -0,0 +1,257 @@
+/*
+ * FDNReverb.h
+ *
+ * This file is part of Mozzi.
+ *
+ * Copyright 2012-2024 Tim Barrass and the Mozzi Team
+ *
+ * Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+ *
+ */
+
+#ifndef FDNREVERB_H_
+#define FDNREVERB_H_
+
+#include <Arduino.h>
+#include "mozzi_pgmspace.h"
+#include "mozzi_utils.h"
+#include "meta.h"
+#include "primes.h"
+
+/*
+Feedback delay network, after Jot & Chaigne (1991) and Julius O. Smith,
+Physical Audio Signal Processing, https://ccrma.stanford.edu/~jos/pasp/FDN_Reverberation.html
+
+for each sample...
+y[i] = lowpass_i(delay_i.read())           // damping in each loop
+m = A * y                                    // lossless mixing matrix
+delay_i.write(in + g * m[i])                 // feedback gain g < 1 sets the decay time
+out = sum of y
+
+The mixing matrix A is orthogonal, so with g < 1 the network always decays.
+With 4 lines it's a 4x4 Hadamard matrix scaled by 1/2, done with two stages of
+butterflies.  With 8 lines it's a Householder reflection, A = I - (2/N) * ones,
+which needs only one sum and a shift.  Either way the matrix costs adds and shifts only.
+*/
+
+
+/** A feedback delay network (FDN) reverb, with 4 or 8 recirculating delay lines of prime lengths,
+a lossless mixing matrix made from adds and shifts, a damping filter in each loop and 16 bit storage.
+It sounds much smoother than ReverbTank, and scales from small rooms on AVR to large halls on boards with more RAM.
+
+The delay lines are carved out of one buffer of NUM_CELLS int16_t cells, so the memory used is fixed at
+compile time, at 2*NUM_CELLS bytes.  The line lengths are spread around NUM_CELLS/NUM_LINES, and each one is
+rounded down to a prime number (from primes.h) so the echoes of different lines don't pile up on each other.
+Lines longer than the largest prime in primes.h (9973) are given odd lengths instead.
+
+@tparam NUM_CELLS total length of all the delay lines together, in samples.
+For example, 512 (1 kB of RAM) suits an atmega328, while 16384 (32 kB) makes a large hall on an RP2040 or ESP32.
+@tparam NUM_LINES 4 (default) or 8 delay lines.  8 lines give a denser, smoother tail for about twice the processing.
+*/
+template <uint16_t NUM_CELLS, uint8_t NUM_LINES = 4>
+class FDNReverb
+{
+
+	static_assert(NUM_LINES == 4 || NUM_LINES == 8, "FDNReverb supports 4 or 8 delay lines");
+	static_assert(NUM_CELLS >= 16 * NUM_LINES, "FDNReverb needs at least 16 cells per delay line");
+
+public:
+	/** Constructor.
+	@param feedback_level how long the reverb rings, from 0 (no recirculation) to 255 (very long), see setFeedbackLevel().
+	@param damping how quickly high frequencies die away, from 0 (bright) to 255 (very dark), see setDamping().
+	*/
+	FDNReverb(uint8_t feedback_level = 220, uint8_t damping = 64): _left(0), _right(0)
+	{
+		for (uint16_t i = 0; i < NUM_CELLS; ++i) buffer[i] = 0;
+		uint16_t offset = 0;
+		for (uint8_t i = 0; i < NUM_LINES; ++i)
+		{
+			offset_cells[i] = offset;
+			max_cells[i] = (uint16_t) (((uint32_t) (NUM_CELLS / NUM_LINES) * (SPREAD + 2 * i)) / (SPREAD + NUM_LINES - 1));
+			offset += max_cells[i];
+			lowpass[i] = 0;
+		}
+		setSize(255);
+		setFeedbackLevel(feedback_level);
+		setDamping(damping);
+	}
+
+
+	/** Set the size of the room, by shortening the delay lines from their full lengths.
+	The lengths are rounded to primes again, so this takes some time and is best done only when the size changes.
+	@param size from 0 (the shortest, about 1/4 of the full lengths) to 255 (the full lengths set by NUM_CELLS).
+	*/
+	void setSize(uint8_t size)
+	{
+		// work down from the longest line, keeping lengths distinct so no two lines share a prime
+		uint16_t ceiling = 0xFFFF;
+		for (int8_t i = NUM_LINES - 1; i >= 0; --i)
+		{
+			uint16_t target = (uint16_t) (((uint32_t) max_cells[i] * (256 + 3 * (uint16_t) size)) >> 10);
+			if (target >= ceiling) target = ceiling - 1;
+			if (target < 2) target = 2; // only for tiny NUM_CELLS, where lines may then share a length
+			uint16_t len = primeAtOrBelow(target);
+			line_cells[i] = len;
+			if (write_pos[i] >= len) write_pos[i] = 0;
+			ceiling = len;
+		}
+	}
+
+
+	/** Set how much of each line's output is fed back into the network, which sets the decay time.
+	@param feedback_level from 0 to 255, representing 0 to 0.996.  Around 200 is a room, 240 a hall.
+	*/
+	inline
+	void setFeedbackLevel(uint8_t feedback_level)
+	{
+		_feedback_level = feedback_level;
+	}
+
+
+	/** Set the damping of high frequencies in the reverb tail.
+	@param damping from 0 (bright, no damping) to 255 (very dark).
+	*/
+	inline
+	void setDamping(uint8_t damping)
+	{
+		_brightness = 256 - damping; // never 0, which would stop the lowpasses and silence the tank
+	}
+
+
+	/** Process the next audio sample and return the reverbed signal.  This returns only the "wet" signal,
+	which can be combined with the dry input signal in the sketch.  The stereo outputs for the same sample can
+	be read afterwards with left() and right().
+	@param input the audio signal to process, up to 15 bits, though leaving a few bits of headroom (eg. -4096 to 4095) keeps loud tails from clipping.
+	@return the mono reverb output, at about the same scale as the input.
+	*/
+	inline
+	int next(int input)
+	{
+		int32_t y[NUM_LINES];
+		for (uint8_t i = 0; i < NUM_LINES; ++i)
+		{
+			int16_t out = buffer[offset_cells[i] + write_pos[i]];
+			lowpass[i] += (int16_t) (((int32_t) (out - lowpass[i]) * _brightness + 128) >> 8); // rounded, so it settles exactly
+			y[i] = lowpass[i];
+		}
+
+		int32_t sum_even = 0, sum_odd = 0;
+		for (uint8_t i = 0; i < NUM_LINES; i += 2)
+		{
+			sum_even += y[i];
+			sum_odd += y[i + 1];
+		}
+		_left = (int) (sum_even >> (LINES_SHIFT - 1));
+		_right = (int) (sum_odd >> (LINES_SHIFT - 1));
+
+		mix(y, Int2Type<NUM_LINES>());
+
+		for (uint8_t i = 0; i < NUM_LINES; ++i)
+		{
+			// round the feedback towards zero, so small signals can't get stuck circulating
+			int32_t scaled = y[i] * _feedback_level;
+			if (scaled < 0) scaled += 255;
+			int32_t fed = input + (scaled >> 8);
+			buffer[offset_cells[i] + write_pos[i]] = (int16_t) constrain(fed, -32768L, 32767L);
+			if (++write_pos[i] >= line_cells[i]) write_pos[i] = 0;
+		}
+		return (int) (((long) _left + _right) >> 1);
+	}
+
+
+	/** The left channel of the last sample calculated by next().  Left and right are taken from different delay lines, for a wide stereo image.
+	@return the left reverb output.
+	*/
+	inline
+	int left()
+	{
+		return _left;
+	}
+
+
+	/** The right channel of the last sample calculated by next().
+	@return the right reverb output.
+	*/
+	inline
+	int right()
+	{
+		return _right;
+	}
+
+
+	/** Get the current length of one of the delay lines, for example to check the primes chosen.
+	@param line which line, from 0 to NUM_LINES-1.
+	@return the length of that line in samples.
+	*/
+	inline
+	uint16_t getLineLength(uint8_t line)
+	{
+		return line_cells[line];
+	}
+
+
+private:
+	// line lengths are spread from SPREAD/(SPREAD+NUM_LINES-1) to (SPREAD+2*NUM_LINES-2)/(SPREAD+NUM_LINES-1) of the mean
+	static const uint8_t SPREAD = 2 * NUM_LINES - 1;
+	static const uint8_t LINES_SHIFT = trailingZerosConst(NUM_LINES);
+
+	int16_t buffer[NUM_CELLS];
+	uint16_t offset_cells[NUM_LINES]; // start of each line in buffer
+	uint16_t max_cells[NUM_LINES]; // room reserved for each line
+	uint16_t line_cells[NUM_LINES]; // current (prime) length of each line
+	uint16_t write_pos[NUM_LINES] = {0};
+	int16_t lowpass[NUM_LINES];
+	uint8_t _feedback_level;
+	uint16_t _brightness; // 1 to 256
+	int _left, _right;
+
+
+	// 4x4 Hadamard matrix scaled by 1/2, as two stages of butterflies
+	inline
+	void mix(int32_t * y, Int2Type<4>)
+	{
+		int32_t a = y[0] + y[1];
+		int32_t b = y[0] - y[1];
+		int32_t c = y[2] + y[3];
+		int32_t d = y[2] - y[3];
+		y[0] = (a + c) >> 1;
+		y[1] = (b + d) >> 1;
+		y[2] = (a - c) >> 1;
+		y[3] = (b - d) >> 1;
+	}
+
+
+	// 8x8 Householder reflection, y - (2/8)*sum(y)
+	inline
+	void mix(int32_t * y, Int2Type<8>)
+	{
+		int32_t sum = 0;
+		for (uint8_t i = 0; i < 8; ++i) sum += y[i];
+		sum >>= 2;
+		for (uint8_t i = 0; i < 8; ++i) y[i] -= sum;
+	}
+
+
+	// largest prime <= n from primes.h, or the largest odd number <= n beyond the end of the table
+	static uint16_t primeAtOrBelow(uint16_t n)
+	{
+		// not TOP_PRIME_INDEX, which assumes 2 byte ints
+		const uint16_t num_primes = sizeof(primes) / sizeof(primes[0]);
+		if (n > FLASH_OR_RAM_READ<const unsigned int>(primes + num_primes - 1)) return (n & 1) ? n : n - 1;
+		uint16_t lo = 0, hi = num_primes - 1;
+		while (lo < hi)
+		{
+			uint16_t mid = (lo + hi + 1) >> 1;
+			if (FLASH_OR_RAM_READ<const unsigned int>(primes + mid) <= n) lo = mid;
+			else hi = mid - 1;
+		}
+		return FLASH_OR_RAM_READ<const unsigned int>(primes + lo);
+	}
+};
+
+/**
+@example 09.Delays/FDNReverb/FDNReverb.ino
+This example demonstrates the FDNReverb class.
+*/
+
+#endif /* FDNREVERB_H_ */
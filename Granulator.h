@@ -0,0 +1,358 @@
+/*
+ * Granulator.h
+ *
+ * This file is part of Mozzi.
+ *
+ * Copyright 2012-2024 Tim Barrass and the Mozzi Team
+ *
+ * Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+ *
+ */
+
+#ifndef GRANULATOR_H_
+#define GRANULATOR_H_
+
+#include "MozziHeadersOnly.h"
+#include "mozzi_fixmath.h"
+#include "mozzi_pgmspace.h"
+#include "mozzi_rand.h"
+#include "mozzi_utils.h"
+
+
+/** A granular synthesis engine which plays many short, enveloped grains from a sound table.
+Each grain has its own start position, playback increment, duration and position in the
+window envelope, but all grains share one sound table and one window table, so the
+memory needed per grain is only a few bytes.  Grains are kept in a fixed pool of
+MAX_GRAINS slots.  The grain state is held in separate arrays for each parameter rather
+than an array of structs, so next() runs through each array in a tight loop and only
+touches the grains which are playing.
+
+New grains can be started by hand with trigger(), or by the built in scheduler in update(),
+which starts grains at a set density (grains per second) with random jitter on the start
+position, timing and pitch of each grain.  The scheduler runs at control rate, and grain
+onsets within a control period are spread out by delaying the start of each grain
+by a number of audio samples, so clouds don't pulse at the control rate.
+
+@tparam NUM_TABLE_CELLS the length of the sound table, as for Sample.  The table can
+be any length up to 65535 cells.  Grains wrap around to the start if they play past the end.
+@tparam WINDOW_NUM_CELLS the number of cells of the window table to use for each grain's envelope.
+This must be a power of two.  The window tables contain unsigned data from 0 to 255.
+tables/envelop2048_uint8.h can be used whole, with WINDOW_NUM_CELLS = ENVELOP2048_NUM_CELLS.
+tables/halfsinwindow512_uint8.h only has its half-sine in the first 256 cells, so use
+WINDOW_NUM_CELLS = HALFSINWINDOW512_NUM_CELLS/2 with that table.
+@tparam CONTROL_UPDATE_RATE how often update() is called, usually MOZZI_CONTROL_RATE.
+@tparam MAX_GRAINS the size of the grain pool, from 1 to 32.  Each grain costs about 16 bytes of RAM.
+On AVR at 16384 Hz, about 4 grains fit in the audio budget alongside a little other synthesis;
+32-bit boards can comfortably run 16 or more.
+*/
+template <unsigned int NUM_TABLE_CELLS, unsigned int WINDOW_NUM_CELLS, unsigned int CONTROL_UPDATE_RATE, uint8_t MAX_GRAINS = 8>
+class Granulator
+{
+
+	static_assert(MAX_GRAINS >= 1 && MAX_GRAINS <= 32, "Granulator supports 1 to 32 grains");
+	static_assert((WINDOW_NUM_CELLS & (WINDOW_NUM_CELLS - 1)) == 0, "WINDOW_NUM_CELLS must be a power of two");
+
+public:
+
+	/** Constructor.
+	@param TABLE_NAME the name of the sound table the grains are taken from, as for Sample.
+	@param WINDOW_TABLE_NAME the name of the table holding the grain envelope, for example HALFSINWINDOW512_DATA or ENVELOP2048_DATA.
+	*/
+	Granulator(const int8_t * TABLE_NAME, const int8_t * WINDOW_TABLE_NAME):
+			table(TABLE_NAME), window(WINDOW_TABLE_NAME), active(0),
+			startpos(0), position_jitter(0), phase_inc(Q16n16_FIX1), pitch_jitter(0),
+			window_inc(0), density_inc(0), density_acc(0), grain_spacing(0), timing_jitter(0)
+	{
+		setDuration(50);
+	}
+
+
+	/** Change the sound table which grains will be read from.  Grains already playing switch to the new table.
+	@param TABLE_NAME is the name of the array in the table ".h" file you're using.
+	*/
+	inline
+	void setTable(const int8_t * TABLE_NAME)
+	{
+		table = TABLE_NAME;
+	}
+
+
+	/** Change the window table used for the grain envelopes.
+	@param WINDOW_TABLE_NAME is the name of the array in the table ".h" file you're using.
+	*/
+	inline
+	void setWindow(const int8_t * WINDOW_TABLE_NAME)
+	{
+		window = WINDOW_TABLE_NAME;
+	}
+
+
+	/** Set the position in the sound table where new grains start.
+	@param position offset from the start of the table, in cells.
+	*/
+	inline
+	void setPosition(unsigned int position)
+	{
+		startpos = position;
+	}
+
+
+	/** Set how far the start of each new grain may randomly stray from the position set with setPosition().
+	@param cells the maximum random offset in cells, added after the position.  0 (default) for no jitter.
+	*/
+	inline
+	void setPositionJitter(unsigned int cells)
+	{
+		position_jitter = cells;
+	}
+
+
+	/** Set the playback speed of new grains, relative to the recorded speed of the sound table, with a Q16n16 fixed-point number.
+	@param speed a Q16n16 fixed point ratio, where Q16n16_FIX1 (65536) plays the table at its original pitch,
+	Q16n16_FIX1*2 an octave higher and Q16n16_FIX1/2 an octave lower.
+	*/
+	inline
+	void setPitch_Q16n16(Q16n16 speed)
+	{
+		phase_inc = speed;
+	}
+
+
+	/** Set the playback speed of new grains, relative to the recorded speed of the sound table.
+	@param speed 1.0 plays the table at its original pitch, 2.0 an octave higher, 0.5 an octave lower.
+	*/
+	inline
+	void setPitch(float speed)
+	{
+		phase_inc = float_to_Q16n16(speed);
+	}
+
+
+	/** Set how much the speed of each new grain may randomly stray above the speed set with setPitch().
+	@param speed_jitter the maximum random amount added to the speed of each grain, in Q0n16 format
+	(65535 is just under double the speed set with setPitch() or setPitch_Q16n16()).  0 (default) for no jitter.
+	*/
+	inline
+	void setPitchJitter(Q0n16 speed_jitter)
+	{
+		pitch_jitter = speed_jitter;
+	}
+
+
+	/** Set the duration of new grains.
+	@param msec the length of each grain in milliseconds, from 1 to the length of 65535 audio samples (4 seconds at 16384 Hz).
+	@note Contains a division, so it's best called only when the duration changes, rather than every control step.
+	*/
+	inline
+	void setDuration(unsigned int msec)
+	{
+		setDurationSamples((uint16_t) min(((uint32_t) msec * MOZZI_AUDIO_RATE) / 1000, (uint32_t) 65535));
+	}
+
+
+	/** Set the duration of new grains, in audio samples.
+	@param num_samples the length of each grain in samples, from 1 to 65535.
+	*/
+	inline
+	void setDurationSamples(uint16_t num_samples)
+	{
+		if (num_samples == 0) num_samples = 1;
+		window_inc = (uint16_t) min(65536UL / num_samples, 65535UL);
+		if (window_inc == 0) window_inc = 1;
+	}
+
+
+	/** Set how many grains the scheduler in update() starts each second.
+	@param grains_per_second density of the grain cloud, from 0, which stops scheduling new grains, to 32767.
+	Overlapping grains are limited to MAX_GRAINS: grains which would start when all slots are busy are skipped.
+	@note Contains a division, so it's best called only when the density changes, rather than every control step.
+	*/
+	inline
+	void setDensity(int grains_per_second)
+	{
+		density_inc = ((uint32_t) grains_per_second << 16) / CONTROL_UPDATE_RATE;
+		grain_spacing = grains_per_second ? MOZZI_AUDIO_RATE / grains_per_second : 0;
+	}
+
+
+	/** Set how many grains the scheduler in update() starts each second.
+	@param grains_per_second density of the grain cloud as a float, which allows fractional densities.
+	*/
+	inline
+	void setDensity(float grains_per_second)
+	{
+		density_inc = (uint32_t) ((grains_per_second * 65536.f) / CONTROL_UPDATE_RATE);
+		grain_spacing = (grains_per_second > 0.f) ? (uint32_t) (MOZZI_AUDIO_RATE / grains_per_second) : 0;
+	}
+
+
+	/** Set how much grain onsets are randomly scattered in time.
+	@param jitter from 0 (default), where grains follow each other at even intervals, to 255, where each grain
+	may start up to one control period later than its regular onset.
+	*/
+	inline
+	void setTimingJitter(uint8_t jitter)
+	{
+		timing_jitter = jitter;
+	}
+
+
+	/** Start a grain now, with the current position, pitch and duration settings and their jitter.
+	If all the grain slots are in use, the grain is not started.
+	@return true if the grain was started.
+	*/
+	inline
+	bool trigger()
+	{
+		return startGrain(0);
+	}
+
+
+	/** Runs the grain scheduler.  Call this in updateControl().
+	It starts the number of grains due in this control period according to setDensity(),
+	spread across the period according to their ideal onset times plus timing jitter.
+	*/
+	void update()
+	{
+		density_acc += density_inc;
+		while (density_acc >= Q16n16_FIX1)
+		{
+			density_acc -= Q16n16_FIX1;
+			// the further the accumulator overshot, the earlier in this control period the grain was due
+			uint32_t early = (density_acc * grain_spacing) >> 16;
+			uint16_t wait = (early < SAMPLES_PER_CONTROL) ? (SAMPLES_PER_CONTROL - 1 - early) : 0;
+			if (timing_jitter) wait += (uint16_t) (((uint32_t) rand(timing_jitter) * SAMPLES_PER_CONTROL) >> 8);
+			startGrain(wait);
+		}
+	}
+
+
+	/** Calculate the next audio sample of the grain cloud.  Call this in updateAudio().
+	@return the sum of all the playing grains, each of which is in the range of an 8 bit signal (-128 to 127) at the peak of its window.
+	With MAX_GRAINS overlapping, the output can reach 8 + log2(MAX_GRAINS) bits, so MonoOutput::fromAlmostNBit(10, ...)
+	is usually about right for a moderately dense cloud of 8 grains.
+	*/
+	inline
+	int next()
+	{
+		int out = 0;
+		uint32_t playing = active;
+		for (uint8_t i = 0; playing; ++i, playing >>= 1)
+		{
+			if (!(playing & 1)) continue;
+			if (grain_wait[i])
+			{
+				--grain_wait[i];
+				continue;
+			}
+			uint32_t phase = grain_phase[i];
+			int8_t sig = FLASH_OR_RAM_READ<const int8_t>(table + (uint16_t) (phase >> 16));
+			uint16_t wphase = grain_window_phase[i];
+			uint8_t amp = (uint8_t) FLASH_OR_RAM_READ<const int8_t>(window + (wphase >> WINDOW_SHIFT));
+			out += ((int) sig * amp) >> 8;
+
+			phase += grain_phase_inc[i];
+			if (phase >= TABLE_END) phase -= TABLE_END;
+			grain_phase[i] = phase;
+
+			uint16_t next_wphase = wphase + grain_window_inc[i];
+			if (next_wphase < wphase) active &= ~((uint32_t) 1 << i); // window finished, free the slot
+			grain_window_phase[i] = next_wphase;
+		}
+		return out;
+	}
+
+
+	/** Stop all grains immediately.
+	*/
+	inline
+	void stop()
+	{
+		active = 0;
+	}
+
+
+	/** Returns the number of grains currently playing or waiting to start.
+	@return the number of busy grain slots.
+	*/
+	inline
+	uint8_t activeGrains()
+	{
+		uint8_t count = 0;
+		for (uint32_t a = active; a; a &= a - 1) ++count;
+		return count;
+	}
+
+
+private:
+
+	static const uint32_t TABLE_END = (uint32_t) NUM_TABLE_CELLS << 16;
+	static const uint32_t ALL_SLOTS = (MAX_GRAINS == 32) ? 0xFFFFFFFFUL : (((uint32_t) 1 << MAX_GRAINS) - 1);
+	static const uint16_t SAMPLES_PER_CONTROL = MOZZI_AUDIO_RATE / CONTROL_UPDATE_RATE;
+	static const uint8_t WINDOW_SHIFT = 16 - trailingZerosConst(WINDOW_NUM_CELLS);
+
+	// per grain state, as separate arrays so next() walks through each one in order
+	uint32_t grain_phase[MAX_GRAINS];          // Q16n16 read position in the sound table
+	uint32_t grain_phase_inc[MAX_GRAINS];      // Q16n16 playback increment
+	uint16_t grain_window_phase[MAX_GRAINS];   // Q0n16 position through the window
+	uint16_t grain_window_inc[MAX_GRAINS];     // Q0n16 window increment, sets the grain duration
+	uint16_t grain_wait[MAX_GRAINS];           // audio samples to wait before the grain starts
+
+	const int8_t * table;
+	const int8_t * window;
+	uint32_t active; // one bit per busy grain slot
+
+	// settings for new grains
+	unsigned int startpos;
+	unsigned int position_jitter;
+	Q16n16 phase_inc;
+	Q0n16 pitch_jitter;
+	uint16_t window_inc;
+
+	// scheduler
+	Q16n16 density_inc;
+	Q16n16 density_acc;
+	uint32_t grain_spacing; // audio samples between grain onsets
+	uint8_t timing_jitter;
+
+
+	inline
+	bool startGrain(uint16_t wait)
+	{
+		uint32_t free_slots = ~active & ALL_SLOTS;
+		if (!free_slots) return false;
+		uint8_t i = 0;
+		while (!(free_slots & 1))
+		{
+			free_slots >>= 1;
+			++i;
+		}
+
+		uint32_t pos = startpos;
+		if (position_jitter) pos += ((xorshift96() & 0xFFFF) * position_jitter) >> 16;
+		while (pos >= NUM_TABLE_CELLS) pos -= NUM_TABLE_CELLS;
+
+		Q16n16 inc = phase_inc;
+		if (pitch_jitter)
+		{
+			uint16_t jitter = ((xorshift96() & 0xFFFF) * pitch_jitter) >> 16; // Q0n16 proportion of the speed to add
+			inc += (phase_inc >> 8) * (jitter >> 8);
+		}
+
+		grain_phase[i] = pos << 16;
+		grain_phase_inc[i] = inc;
+		grain_window_phase[i] = 0;
+		grain_window_inc[i] = window_inc;
+		grain_wait[i] = wait;
+		active |= (uint32_t) 1 << i;
+		return true;
+	}
+
+};
+
+/**
+@example 08.Samples/Sample_Granular/Sample_Granular.ino
+This example demonstrates the Granulator class.
+*/
+
+#endif /* GRANULATOR_H_ */
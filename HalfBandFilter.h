@@ -0,0 +1,208 @@
+/*
+ * HalfBandFilter.h
+ *
+ * This file is part of Mozzi.
+ *
+ * Copyright 2012-2024 Tim Barrass and the Mozzi Team
+ *
+ * Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+ *
+ */
+
+#ifndef HALFBANDFILTER_H_
+#define HALFBANDFILTER_H_
+
+#include <Arduino.h>
+#include "mozzi_pgmspace.h"
+
+/*
+Half-band polyphase FIR filters, for changing the sample rate by a factor of 2.
+
+A half-band lowpass of 4*K-1 taps, h[0..4K-2], cuts off at a quarter of the sample rate,
+and has h = 0.5 at the centre, h[2K-1], and zero at every even distance from it.
+The tables in tables/halfband*_int16.h hold the K taps at distances 1, 3, 5... as Q15,
+c[0] the closest, and are made by extras/python/halfband_fir.py.
+
+Decimating by 2, only every other output is needed, so the filter splits into two phases:
+y[m] = 0.5 * x[2m-2K+1] + sum(c[i] * (x[2m-2K+2+2i] + x[2m-2K-2i]))
+The odd input samples only meet the centre tap, and the even ones only the others,
+which costs K multiplies for every output, or K/2 per input sample.
+
+Interpolating by 2 is the same filter run on the input with zeros between the samples,
+with a gain of 2.  The zeros don't need multiplying, so the two phases are:
+y[2n] = 2 * sum(c[i] * (x[n-K+1+i] + x[n-K-i]))
+y[2n+1] = x[n-K+1]
+*/
+
+
+/** Halves the sample rate of a signal, with a half-band lowpass filter to stop the frequencies
+above the new half sample rate from aliasing.  For example, it can take MOZZI_AUDIO_RATE audio
+from getAudioInput() or a table down to MOZZI_AUDIO_RATE/2 for an effect which doesn't need the whole rate,
+or two decimators in series can go down to MOZZI_AUDIO_RATE/4.  Pairs with HalfBandInterpolator to get back up again.
+
+The filter's coefficients come from one of the tables in tables/halfband*_int16.h:
+- HALFBAND7 (7 taps) costs 2 multiplies per output sample and keeps up to 1/20 of the input rate, for AVR.
+- HALFBAND15 (15 taps) costs 4, and keeps up to 0.16 of the input rate.
+- HALFBAND31 (31 taps) costs 8, and keeps up to 0.19 of the input rate with more than 80 dB rejection of the rest.
+The output is delayed by 2*NUM_COEFFS-1 input samples.
+
+@tparam NUM_COEFFS the number of coefficients in the table, given by its _NUM_COEFFS, for example HALFBAND15_NUM_COEFFS.
+*/
+template <uint8_t NUM_COEFFS>
+class HalfBandDecimator
+{
+
+public:
+	/** Constructor.
+	@param TABLE_NAME the name of the coefficient table, for example HALFBAND15_DATA.
+	*/
+	HalfBandDecimator(const int16_t * TABLE_NAME): pos(0), odd_pos(0)
+	{
+		// copied to RAM, which is quicker to read every sample
+		for (uint8_t i = 0; i < NUM_COEFFS; ++i) c[i] = FLASH_OR_RAM_READ<const int16_t>(TABLE_NAME + i);
+		for (uint8_t i = 0; i < 2 * EVEN_LENGTH; ++i) even[i] = 0;
+		for (uint8_t i = 0; i < 2 * NUM_COEFFS; ++i) odd[i] = 0;
+	}
+
+
+	/** Take the next two input samples and give one output sample at half the rate.
+	@param in_first the earlier of the two input samples, up to 15 bits.
+	@param in_second the later of the two.
+	@return the output, at the same scale as the input.
+	*/
+	inline
+	int next(int in_first, int in_second)
+	{
+		// each history is written twice, so it can be read from pos without wrapping around
+		if (pos == 0) pos = EVEN_LENGTH;
+		--pos;
+		even[pos] = even[pos + EVEN_LENGTH] = in_second;
+		if (odd_pos == 0) odd_pos = NUM_COEFFS;
+		--odd_pos;
+		odd[odd_pos] = odd[odd_pos + NUM_COEFFS] = in_first;
+
+		// even[pos + j] is x[2m-2j], odd[odd_pos + j] is x[2m-1-2j]
+		const int16_t * e = even + pos;
+		int32_t acc = (int32_t) odd[odd_pos + NUM_COEFFS - 1] << 14;
+		for (uint8_t i = 0; i < NUM_COEFFS; ++i)
+		{
+			acc += (int32_t) c[i] * (e[NUM_COEFFS - 1 - i] + e[NUM_COEFFS + i]);
+		}
+		return (int) constrain((acc + (1L << 14)) >> 15, -32768L, 32767L);
+	}
+
+
+	/** Decimate a block of samples, with the same result as calling next() on each pair.
+	@param input 2*num_output_samples input samples.
+	@param output where to write the output, which can be the same as input.
+	@param num_output_samples how many samples to output.
+	*/
+	void next(const int * input, int * output, uint16_t num_output_samples)
+	{
+		for (uint16_t n = 0; n < num_output_samples; ++n)
+		{
+			output[n] = next(input[2 * n], input[2 * n + 1]); // output[n] is written after input[2n+1] is read
+		}
+	}
+
+
+private:
+	static const uint8_t EVEN_LENGTH = 2 * NUM_COEFFS;
+
+	int16_t c[NUM_COEFFS];
+	int16_t even[2 * EVEN_LENGTH];
+	int16_t odd[2 * NUM_COEFFS];
+	uint8_t pos, odd_pos;
+};
+
+
+
+/** Doubles the sample rate of a signal, with a half-band lowpass filter to remove the image of the signal
+which would otherwise appear mirrored above the old half sample rate.  For example, an effect run at
+MOZZI_AUDIO_RATE/2 can be brought back up to MOZZI_AUDIO_RATE to mix with the rest of the sound.
+
+Each call to next() takes one input sample and gives the first of two output samples, and second()
+gives the other one, so in updateAudio() next() can be called on one frame and second() on the next.
+The filter costs NUM_COEFFS multiplies for each input sample, all of them in next().
+The tables are the same as for HalfBandDecimator, and the output is delayed by 2*NUM_COEFFS-1 output samples.
+
+@tparam NUM_COEFFS the number of coefficients in the table, given by its _NUM_COEFFS, for example HALFBAND15_NUM_COEFFS.
+*/
+template <uint8_t NUM_COEFFS>
+class HalfBandInterpolator
+{
+
+public:
+	/** Constructor.
+	@param TABLE_NAME the name of the coefficient table, for example HALFBAND15_DATA.
+	*/
+	HalfBandInterpolator(const int16_t * TABLE_NAME): pos(0), _second(0)
+	{
+		for (uint8_t i = 0; i < NUM_COEFFS; ++i) c[i] = FLASH_OR_RAM_READ<const int16_t>(TABLE_NAME + i);
+		for (uint8_t i = 0; i < 2 * LENGTH; ++i) x[i] = 0;
+	}
+
+
+	/** Take the next input sample and give the first of the two output samples at twice the rate.
+	@param input the input sample, up to 15 bits.
+	@return the first output sample, at the same scale as the input.
+	*/
+	inline
+	int next(int input)
+	{
+		if (pos == 0) pos = LENGTH;
+		--pos;
+		x[pos] = x[pos + LENGTH] = input;
+
+		// h[pos + j] is x[n-j]
+		const int16_t * h = x + pos;
+		int32_t acc = 0;
+		for (uint8_t i = 0; i < NUM_COEFFS; ++i)
+		{
+			acc += (int32_t) c[i] * (h[NUM_COEFFS - 1 - i] + h[NUM_COEFFS + i]);
+		}
+		_second = h[NUM_COEFFS - 1];
+		return (int) constrain((acc + (1L << 13)) >> 14, -32768L, 32767L);
+	}
+
+
+	/** The second of the two output samples for the last input given to next().
+	@return the second output sample.
+	*/
+	inline
+	int second()
+	{
+		return _second;
+	}
+
+
+	/** Interpolate a block of samples, with the same result as calling next() and second() for each one.
+	@param input the input samples.
+	@param output where to write 2*num_input_samples output samples, which must not overlap the input.
+	@param num_input_samples how many samples to read.
+	*/
+	void next(const int * input, int * output, uint16_t num_input_samples)
+	{
+		for (uint16_t n = 0; n < num_input_samples; ++n)
+		{
+			output[2 * n] = next(input[n]);
+			output[2 * n + 1] = _second;
+		}
+	}
+
+
+private:
+	static const uint8_t LENGTH = 2 * NUM_COEFFS;
+
+	int16_t c[NUM_COEFFS];
+	int16_t x[2 * LENGTH];
+	uint8_t pos;
+	int _second;
+};
+
+/**
+@example 10.Audio_Filters/HalfBandFilter/HalfBandFilter.ino
+This example demonstrates the HalfBandDecimator and HalfBandInterpolator classes.
+*/
+
+#endif        //  #ifndef HALFBANDFILTER_H_
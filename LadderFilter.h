@@ -0,0 +1,209 @@
+/*
+ * LadderFilter.h
+ *
+ * This file is part of Mozzi.
+ *
+ * Copyright 2012-2024 Tim Barrass and the Mozzi Team
+ *
+ * Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+ *
+ */
+
+#ifndef LADDERFILTER_H_
+#define LADDERFILTER_H_
+
+#include "IntegerType.h"
+#include "AudioOutput.h"
+#include "meta.h"
+#include "mozzi_pgmspace.h"
+#include "ResonantFilter.h"
+#include "tables/tanh65_uint16.h"
+#include "tables/laddertuning257_uint16.h"
+
+
+/*
+Four pole "ladder" filter, after the Moog transistor ladder as simplified by
+Antti Huovilainen, "Non-linear digital implementation of the Moog ladder filter", DAFx 2004,
+with one saturating stage at the input instead of one per pole.
+
+for each sample...
+u = tanh(in - k * y4);          // k from 0 to 5, about 4 is the edge of self-oscillation
+y1 += g * (u - y1);             // four identical one pole lowpasses
+y2 += g * (y1 - y2);
+y3 += g * (y2 - y3);
+y4 += g * (y3 - y4);              // y4 is fed back as the average of its last two values
+out = y4;                                   // LowPass, 24 dB/octave
+out = u - 4*y1 + 6*y2 - 4*y3 + y4;          // HighPass, 24 dB/octave
+out = 4 * (y2 - 2*y3 + y4);                 // BandPass, 12 dB/octave each side
+out = u - 2*y1 + 2*y2;                      // Notch
+(the other outputs are mixes of the poles, as in the Oberheim Xpander)
+
+Every one pole stage averages its input with its last output, so none of them
+can go beyond the limit of tanh, and the filter stays bounded however much
+resonance or input it is given.
+The signal is kept with 7 extra bits below the input (8 for the 16 bit version)
+so the stages don't stall at low cutoffs.
+*/
+
+
+/** A four pole (24 dB/octave) resonant "ladder" filter, with a tanh-shaped saturation
+in its feedback loop, for fat bass sounds which hold together at high resonance.
+Compared with two ResonantFilters in series, the resonance comes from one loop around all four poles,
+so it peaks sharply and can ring on by itself at the top of its range, and only one cutoff needs setting.
+Each sample costs six multiplies and two table reads, about the same as two ResonantFilter::next() calls.
+
+Like ResonantFilter, there is an 8 bit version, LadderFilter<FILTER_TYPE> or LadderFilter<FILTER_TYPE, uint8_t>, whose
+cutoff and resonance are 0-255 and which expects 8 bit input, and a 16 bit version, LadderFilter<FILTER_TYPE, uint16_t>,
+whose cutoff and resonance are 0-65535, for 16 bit input.
+The input goes through the saturation, so louder signals are softly clipped at about those sizes.
+The lowpass loses some bass as the resonance goes up, as the original does, down to 1/6 at the most resonant.
+@tparam FILTER_TYPE choose between LOWPASS, BANDPASS, HIGHPASS and NOTCH.
+@tparam su the type used for the cutoff and resonance, uint8_t (default) or uint16_t.
+*/
+template<int8_t FILTER_TYPE, typename su=uint8_t>
+class LadderFilter
+{
+
+  static_assert(sizeof(su) == 1 || sizeof(su) == 2, "LadderFilter is made for uint8_t or uint16_t");
+
+public:
+  /** Constructor.
+   */
+  LadderFilter(): g(0), k(0), y1(0), y2(0), y3(0), y4(0), y4_last(0) { ; }
+
+  /** Set the cut off frequency and resonance.
+  @param cutoff range 0-255 for the 8 bit version, 0-65535 for the 16 bit version, representing the
+  one pole coefficient from 0 to 1.  Higher values rise quickly through the top of the audio range,
+  so setCutoffHz() is easier to use for sweeps.
+  @param resonance range 0-255 for the 8 bit version, 0-65535 for the 16 bit version, 255/65535 is most resonant.
+  */
+  void setCutoffFreqAndResonance(su cutoff, su resonance)
+  {
+    g = cutoff;
+    k = resonance;
+  }
+
+  /** Set the cut off frequency, keeping the resonance.
+  @param cutoff in the same range as setCutoffFreqAndResonance().
+  */
+  void setCutoffFreq(su cutoff)
+  {
+    g = cutoff;
+  }
+
+  /** Set the resonance, keeping the cut off frequency.
+  @param resonance in the same range as setCutoffFreqAndResonance(), 255/65535 is most resonant.
+  */
+  void setResonance(su resonance)
+  {
+    k = resonance;
+  }
+
+  /** Set the cut off frequency in Hz, keeping the resonance.
+  The coefficient comes from a table which puts the resonant peak at the frequency given, interpolated like
+  ResonantFilter::setCutoffHz(), so it's fast enough to call at every control update.
+  @param cutoff_hz the cutoff frequency in Hz, up to MOZZI_AUDIO_RATE/4.
+  */
+  void setCutoffHz(uint16_t cutoff_hz)
+  {
+    uint16_t coeff = filterTableFromHz(LADDERTUNING257_DATA, cutoff_hz);
+    g = (sizeof(su) == 1) ? (su) (coeff >> 8) : (su) coeff;
+  }
+
+  /** Calculate the next sample, given an input signal.
+  @param in the signal input, 8 bits for the 8 bit version, 16 bits for the 16 bit version.
+  @return the signal output, at the same scale as the input.
+  */
+  inline AudioOutputStorage_t next(AudioOutputStorage_t in)
+  {
+    return (AudioOutputStorage_t) (step(in, g, k, y1, y2, y3, y4, y4_last) >> EXTRA_BITS);
+  }
+
+  /** Filter a block of samples, with the same result as calling next() on each one.
+  @param input the input samples.
+  @param output where to write the filtered samples, which can be the same as input.
+  @param num_samples how many samples to process.
+  */
+  void next(const AudioOutputStorage_t * input, AudioOutputStorage_t * output, uint16_t num_samples)
+  {
+    // work on local copies, so the state stays in registers for the whole block
+    const su bg = g, bk = k;
+    state_t b1 = y1, b2 = y2, b3 = y3, b4 = y4, b4_last = y4_last;
+    for (uint16_t n = 0; n < num_samples; ++n)
+    {
+      output[n] = (AudioOutputStorage_t) (step(input[n], bg, bk, b1, b2, b3, b4, b4_last) >> EXTRA_BITS);
+    }
+    y1 = b1; y2 = b2; y3 = b3; y4 = b4; y4_last = b4_last;
+  }
+
+private:
+  // 16 bit state with 7 extra bits for the 8 bit version, 32 bit state with 8 extra bits for the 16 bit version
+  typedef typename IntegerType<sizeof(su)+sizeof(su)>::signed_type state_t;
+  static const uint8_t EXTRA_BITS = (sizeof(su) == 1) ? 7 : 8;
+  // the most the saturation gives out, in the state's scale
+  static const uint8_t LIMIT_BITS = (sizeof(su) << 3) - 1 + EXTRA_BITS;
+
+  su g, k;
+  state_t y1, y2, y3, y4, y4_last;
+
+
+  static inline int32_t step(AudioOutputStorage_t in, su g, su k, state_t & y1, state_t & y2, state_t & y3, state_t & y4, state_t & y4_last)
+  {
+    // feeding back the average of the last two outputs puts a zero at the Nyquist frequency, so the loop can't whistle there
+    int32_t u = ((int32_t) in << EXTRA_BITS) - feedback((y4 >> 1) + (y4_last >> 1), k, Int2Type<sizeof(su)>());
+    y4_last = y4;
+    state_t x = saturate(u);
+    y1 += onePole(x - y1, g, Int2Type<sizeof(su)>());
+    y2 += onePole(y1 - y2, g, Int2Type<sizeof(su)>());
+    y3 += onePole(y2 - y3, g, Int2Type<sizeof(su)>());
+    y4 += onePole(y3 - y4, g, Int2Type<sizeof(su)>());
+    return current(x, y1, y2, y3, y4, Int2Type<FILTER_TYPE>());
+  }
+
+  // k * y, with k from 0 to 5, so the most resonant settings are past the edge of self-oscillation at any cutoff
+  static inline int32_t feedback(state_t y, su k, Int2Type<1>) { int32_t p = (int32_t) y * k; return (p >> 6) + (p >> 8); }
+  static inline int32_t feedback(state_t y, su k, Int2Type<2>) { int32_t p = (int32_t) (y >> 8) * k; return (p >> 6) + (p >> 8); }
+
+  // the states stay within the limit, so the difference fits in state_t and the product fits in 32 bits
+  static inline state_t onePole(state_t d, su g, Int2Type<1>) { return (state_t) (((int32_t) d * g) >> 8); }
+  static inline state_t onePole(state_t d, su g, Int2Type<2>) { return (state_t) (((d >> 8) * (int32_t) (g >> 1)) >> 7); }
+
+  // limit * tanh(u / limit), interpolated from a table covering 0 to 4 * limit
+  static inline state_t saturate(int32_t u)
+  {
+    uint32_t a = (u < 0) ? -u : u;
+    state_t y;
+    if (a >= (4UL << LIMIT_BITS)) {
+      y = fromQ15(FLASH_OR_RAM_READ<const uint16_t>(TANH65_DATA + 64));
+    } else {
+      uint32_t pos = a >> (LIMIT_BITS - 12); // 16 cells for every limit, as Q8 fraction
+      uint8_t index = pos >> 8;
+      uint8_t fraction = pos;
+      uint16_t t0 = FLASH_OR_RAM_READ<const uint16_t>(TANH65_DATA + index);
+      uint16_t t1 = FLASH_OR_RAM_READ<const uint16_t>(TANH65_DATA + index + 1);
+      uint16_t t = t0 + (((uint32_t) (t1 - t0) * fraction) >> 8);
+      y = fromQ15(t);
+    }
+    return (u < 0) ? -y : y;
+  }
+
+  static inline state_t fromQ15(uint16_t t)
+  {
+    return (state_t) (((int32_t) t << (LIMIT_BITS > 15 ? LIMIT_BITS - 15 : 0)) >> (LIMIT_BITS > 15 ? 0 : 15 - LIMIT_BITS));
+  }
+
+  static inline int32_t current(state_t x, state_t y1, state_t y2, state_t y3, state_t y4, Int2Type<LOWPASS>) {return y4;}
+
+  static inline int32_t current(state_t x, state_t y1, state_t y2, state_t y3, state_t y4, Int2Type<HIGHPASS>) {return (int32_t) x - 4 * (int32_t) y1 + 6 * (int32_t) y2 - 4 * (int32_t) y3 + y4;}
+
+  static inline int32_t current(state_t x, state_t y1, state_t y2, state_t y3, state_t y4, Int2Type<BANDPASS>) {return 4 * ((int32_t) y2 - 2 * (int32_t) y3 + y4);}
+
+  static inline int32_t current(state_t x, state_t y1, state_t y2, state_t y3, state_t y4, Int2Type<NOTCH>) {return (int32_t) x - 2 * (int32_t) y1 + 2 * (int32_t) y2;}
+};
+
+/**
+@example 10.Audio_Filters/LadderFilter/LadderFilter.ino
+This example demonstrates the LadderFilter class.
+*/
+
+#endif /* LADDERFILTER_H_ */
@@ -16,6 +16,26 @@
 #include <Arduino.h>
 
 #include<FixMath.h>
+#include "mozzi_utils.h"
+
+
+namespace MozziPrivate {
+
+/* difference / NUM_STEPS, rounded towards 0 like a division, but with a shift if NUM_STEPS is a power of two,
+which it usually is, as MOZZI_AUDIO_RATE / MOZZI_CONTROL_RATE.  Otherwise the divisor is a constant, which
+compilers can turn into a multiply, except for 32 bit numbers on AVR. */
+template <unsigned long NUM_STEPS, class D>
+inline D divideByStepsConst(D difference)
+{
+	static_assert(NUM_STEPS > 0, "NUM_STEPS must be at least 1");
+	if ((NUM_STEPS & (NUM_STEPS - 1)) == 0)
+	{
+		return (difference < 0) ? -(D) (-difference >> trailingZerosConst(NUM_STEPS)) : (D) (difference >> trailingZerosConst(NUM_STEPS));
+	}
+	return difference / (D) NUM_STEPS;
+}
+
+}
 
 /** For linear changes with a minimum of calculation at each step. For instance,
 you can use Line to make an oscillator glide from one frequency to another,
@@ -30,6 +50,12 @@ scale up the numbers you're using, so internal calculations don't get truncated
 away. Use Mozzi's fixed-point number types in mozzi_fixmath.h, which enable you to
 represent fractional numbers. Google "fixed point arithmetic" if this is new to
 you.
+
+set(targetvalue, num_steps) divides to find the step size, which is slow on AVR, using software floats for
+unsigned char, unsigned int and unsigned long.  When the number of steps is known when compiling,
+as it usually is, like MOZZI_AUDIO_RATE / MOZZI_CONTROL_RATE for a Line interpolating a control in updateAudio(),
+setTarget\<NUM_STEPS\>(targetvalue), which every Line has, including those of UFix and SFix numbers,
+works out the same step without dividing at run time, as long as NUM_STEPS is a power of two.
 */
 
 
@@ -106,6 +132,18 @@ public:
 		set(startvalue);
 		set(targetvalue, num_steps);
 	}
+
+	/** Given a target value, and the number of steps to take on the way as a template parameter, this calculates the
+	step size needed to get there from the current value, without dividing at run time if NUM_STEPS is a power of two.
+	@tparam NUM_STEPS how many steps to take to reach the target, for example MOZZI_AUDIO_RATE / MOZZI_CONTROL_RATE.
+	@param targetvalue the value to move towards.
+	 */
+	template <unsigned long NUM_STEPS>
+	inline
+	void setTarget(T targetvalue)
+	{
+		step_size = MozziPrivate::divideByStepsConst<NUM_STEPS>((T) (targetvalue - current_value));
+	}
 };
 
 
@@ -174,6 +212,18 @@ public:
 		set(startvalue);
 		set(targetvalue, num_steps);
 	}
+
+	/** Given a target value, and the number of steps to take on the way as a template parameter, this calculates the
+	step size needed to get there from the current value, without floats, and without dividing at run time if NUM_STEPS is a power of two.
+	@tparam NUM_STEPS how many steps to take to reach the target, for example MOZZI_AUDIO_RATE / MOZZI_CONTROL_RATE.
+	@param targetvalue the value to move towards.
+	 */
+	template <unsigned long NUM_STEPS>
+	inline
+	void setTarget(unsigned char targetvalue)
+	{
+		step_size = (char) MozziPrivate::divideByStepsConst<NUM_STEPS>((int) targetvalue - current_value);
+	}
 	
 };
 	
@@ -244,6 +294,18 @@ public:
 		set(startvalue);
 		set(targetvalue, num_steps);
 	}
+
+	/** Given a target value, and the number of steps to take on the way as a template parameter, this calculates the
+	step size needed to get there from the current value, without floats, and without dividing at run time if NUM_STEPS is a power of two.
+	@tparam NUM_STEPS how many steps to take to reach the target, for example MOZZI_AUDIO_RATE / MOZZI_CONTROL_RATE.
+	@param targetvalue the value to move towards.
+	 */
+	template <unsigned long NUM_STEPS>
+	inline
+	void setTarget(unsigned int targetvalue)
+	{
+		step_size = (int) MozziPrivate::divideByStepsConst<NUM_STEPS>((long) targetvalue - (long) current_value);
+	}
 };
 
 
@@ -315,6 +377,18 @@ public:
 		set(startvalue);
 		set(targetvalue, num_steps);
 	}
+
+	/** Given a target value, and the number of steps to take on the way as a template parameter, this calculates the
+	step size needed to get there from the current value, without floats, and without dividing at run time if NUM_STEPS is a power of two.
+	@tparam NUM_STEPS how many steps to take to reach the target, for example MOZZI_AUDIO_RATE / MOZZI_CONTROL_RATE.
+	@param targetvalue the value to move towards.
+	 */
+	template <unsigned long NUM_STEPS>
+	inline
+	void setTarget(unsigned long targetvalue)
+	{
+		step_size = MozziPrivate::divideByStepsConst<NUM_STEPS>((long) (targetvalue - current_value));
+	}
 };
 
 
@@ -397,7 +471,20 @@ public:
   {
     set(startvalue);
     set(targetvalue, num_steps);
-  }  
+  }
+
+  /** Given a target value, and the number of steps to take on the way as a template parameter, this calculates the
+      step size needed to get there from the current value, without dividing at run time if NUM_STEPS is a power of two.
+      @tparam NUM_STEPS how many steps to take to reach the target, for example MOZZI_AUDIO_RATE / MOZZI_CONTROL_RATE.
+      @param targetvalue the value to move towards.
+  */
+  template <unsigned long NUM_STEPS>
+  inline
+  void setTarget(internal_type targetvalue)
+  {
+    auto numerator = targetvalue-current_value;
+    step_size = decltype(step_size)::fromRaw(MozziPrivate::divideByStepsConst<NUM_STEPS>(numerator.asRaw()));
+  }
 };
 
 
@@ -480,7 +567,20 @@ public:
   {
     set(startvalue);
     set(targetvalue, num_steps);
-  }  
+  }
+
+  /** Given a target value, and the number of steps to take on the way as a template parameter, this calculates the
+      step size needed to get there from the current value, without dividing at run time if NUM_STEPS is a power of two.
+      @tparam NUM_STEPS how many steps to take to reach the target, for example MOZZI_AUDIO_RATE / MOZZI_CONTROL_RATE.
+      @param targetvalue the value to move towards.
+  */
+  template <unsigned long NUM_STEPS>
+  inline
+  void setTarget(internal_type targetvalue)
+  {
+    auto numerator = targetvalue-current_value;
+    step_size = decltype(step_size)::fromRaw(MozziPrivate::divideByStepsConst<NUM_STEPS>(numerator.asRaw()));
+  }
 };
 
 
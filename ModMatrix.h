@@ -0,0 +1,332 @@
+/*
+ * ModMatrix.h
+ *
+ * This file is part of Mozzi.
+ *
+ * Copyright 2012-2024 Tim Barrass and the Mozzi Team
+ *
+ * Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+ *
+ */
+
+#ifndef MODMATRIX_H_
+#define MODMATRIX_H_
+
+#include <Arduino.h>
+#include "mozzi_pgmspace.h"
+#include "mozzi_fixmath.h"
+
+
+/** A bank of low frequency oscillators for modulation, reading the same wavetables as Oscil, all advanced with one update().
+Each LFO has its own frequency, table and phase offset, and they all start from the phase they're given,
+so LFOs at the same or related frequencies stay in step, for instance in quadrature with offsets a quarter of a cycle apart,
+until sync() starts them all together again.
+Their values are usually fed to a ModMatrix as sources.
+@tparam NUM_LFOS how many LFOs there are.
+@tparam NUM_TABLE_CELLS the length of the tables, a power of two, as for Oscil.
+@tparam UPDATE_RATE how often update() is called, usually MOZZI_CONTROL_RATE.
+*/
+template <uint8_t NUM_LFOS, uint16_t NUM_TABLE_CELLS, unsigned int UPDATE_RATE>
+class LFOBank
+{
+
+public:
+	/** Constructor.
+	@param TABLE_NAME the name of the array all the LFOs read to start with, from a table file in the Mozzi/tables folder.
+	*/
+	LFOBank(const int8_t * TABLE_NAME)
+	{
+		for (uint8_t i = 0; i < NUM_LFOS; ++i)
+		{
+			tables[i] = TABLE_NAME;
+			phase_fractional[i] = phase_increment_fractional[i] = 0;
+			offsets[i] = 0;
+			values[i] = 0;
+		}
+	}
+
+
+	/** Change the table an LFO reads.
+	@param lfo which LFO, from 0 to NUM_LFOS-1.
+	@param TABLE_NAME the name of the array, with NUM_TABLE_CELLS cells, from a table file in the Mozzi/tables folder.
+	*/
+	inline
+	void setTable(uint8_t lfo, const int8_t * TABLE_NAME)
+	{
+		tables[lfo] = TABLE_NAME;
+	}
+
+
+	/** Set an LFO's frequency in whole Hz.
+	@param lfo which LFO, from 0 to NUM_LFOS-1.
+	@param frequency in Hz.
+	*/
+	inline
+	void setFreq(uint8_t lfo, int frequency)
+	{
+		phase_increment_fractional[lfo] = ((uint32_t) frequency) * ((F_BITS_AS_MULTIPLIER * NUM_TABLE_CELLS) / UPDATE_RATE);
+	}
+
+
+	/** Set an LFO's frequency with a Q16n16 fixed-point number, for the slow frequencies LFOs usually have.
+	@param lfo which LFO, from 0 to NUM_LFOS-1.
+	@param frequency in Hz, a Q16n16 number, for instance float_to_Q16n16(0.25) for one cycle every 4 seconds.
+	*/
+	inline
+	void setFreq_Q16n16(uint8_t lfo, Q16n16 frequency)
+	{
+		if (NUM_TABLE_CELLS >= UPDATE_RATE) {
+			phase_increment_fractional[lfo] = ((uint32_t) frequency) * (NUM_TABLE_CELLS / UPDATE_RATE);
+		} else {
+			phase_increment_fractional[lfo] = ((uint32_t) frequency) / (UPDATE_RATE / NUM_TABLE_CELLS);
+		}
+	}
+
+
+	/** Set where an LFO's cycle starts, relative to the others, from the next sync().
+	@param lfo which LFO, from 0 to NUM_LFOS-1.
+	@param offset the phase, in cells of the table, from 0 to NUM_TABLE_CELLS-1.
+	*/
+	inline
+	void setPhaseOffset(uint8_t lfo, uint16_t offset)
+	{
+		offsets[lfo] = offset;
+	}
+
+
+	/** Start all the LFOs' cycles again together, each from its phase offset.
+	*/
+	void sync()
+	{
+		for (uint8_t i = 0; i < NUM_LFOS; ++i) phase_fractional[i] = (uint32_t) offsets[i] << F_BITS;
+	}
+
+
+	/** Advance all the LFOs.  Call this once in updateControl(), then read them with value().
+	*/
+	void update()
+	{
+		for (uint8_t i = 0; i < NUM_LFOS; ++i)
+		{
+			phase_fractional[i] += phase_increment_fractional[i];
+			values[i] = FLASH_OR_RAM_READ<const int8_t>(tables[i] + ((phase_fractional[i] >> F_BITS) & (NUM_TABLE_CELLS - 1)));
+		}
+	}
+
+
+	/** The value of an LFO, as it was at the last update().
+	@param lfo which LFO, from 0 to NUM_LFOS-1.
+	@return the value, from -128 to 127.
+	*/
+	inline
+	int8_t value(uint8_t lfo) const
+	{
+		return values[lfo];
+	}
+
+
+private:
+	static const uint32_t F_BITS = 16;
+	static const uint32_t F_BITS_AS_MULTIPLIER = 65536UL;
+
+	const int8_t * tables[NUM_LFOS];
+	uint32_t phase_fractional[NUM_LFOS];
+	uint32_t phase_increment_fractional[NUM_LFOS];
+	uint16_t offsets[NUM_LFOS];
+	int8_t values[NUM_LFOS];
+};
+
+
+
+/** Routes modulation sources, like the LFOs of an LFOBank and envelopes, to destinations like frequencies,
+filter cutoffs and levels, each with a fixed-point depth, and calls each destination's setter when its value changes.
+Each destination has a base value, which the sources' contributions are added to, and a range the result is kept within.
+The sources and destinations are numbered, usually with an enum in the sketch, like enum {CUTOFF, PITCH};.
+
+update() goes through the routes in one pass, only multiplying again for those whose source has changed,
+and then only works out and sets the destinations which one of those routes goes to, and only calls the setter if
+the result is different from the last one, so a slow LFO or a sustaining envelope costs little.
+
+@tparam NUM_SOURCES how many sources there are.
+@tparam NUM_DESTINATIONS how many destinations there are.
+@tparam MAX_ROUTES the most routes there can be from sources to destinations.
+*/
+template <uint8_t NUM_SOURCES, uint8_t NUM_DESTINATIONS, uint8_t MAX_ROUTES>
+class ModMatrix
+{
+
+public:
+	/** The type of the functions which set a destination, which are given its new value. */
+	typedef void (*setter_t)(int value);
+
+
+	/** Constructor.  There are no routes, and the destinations have no setters, a base of 0,
+	and a range from -32768 to 32767.
+	*/
+	ModMatrix(): num_routes(0)
+	{
+		for (uint8_t s = 0; s < NUM_SOURCES; ++s)
+		{
+			sources[s] = 0;
+			source_changed[s] = false;
+		}
+		for (uint8_t d = 0; d < NUM_DESTINATIONS; ++d)
+		{
+			setters[d] = 0;
+			bases[d] = 0;
+			sums[d] = 0;
+			minimums[d] = -32768;
+			maximums[d] = 32767;
+			outputs[d] = 0;
+			destination_changed[d] = UNCHANGED;
+		}
+	}
+
+
+	/** Set up a destination.  Its setter is called at the next update(), whether its value has changed or not.
+	@param destination which destination, from 0 to NUM_DESTINATIONS-1.
+	@param setter the function to call with its new value, or 0 to just read it with value().
+	@param base the value before any modulation is added.
+	@param minimum the lowest value it can be modulated to.
+	@param maximum the highest value it can be modulated to.
+	*/
+	void setDestination(uint8_t destination, setter_t setter, int base = 0, int minimum = -32768, int maximum = 32767)
+	{
+		setters[destination] = setter;
+		minimums[destination] = minimum;
+		maximums[destination] = maximum;
+		bases[destination] = base;
+		destination_changed[destination] = RESEND;
+	}
+
+
+	/** Change the base value of a destination, for instance from a knob.
+	@param destination which destination, from 0 to NUM_DESTINATIONS-1.
+	@param base the value before any modulation is added.
+	*/
+	inline
+	void setBase(uint8_t destination, int base)
+	{
+		bases[destination] = base;
+		if (destination_changed[destination] == UNCHANGED) destination_changed[destination] = CHANGED;
+	}
+
+
+	/** Add a route from a source to a destination.
+	@param source which source, from 0 to NUM_SOURCES-1.
+	@param destination which destination, from 0 to NUM_DESTINATIONS-1.
+	@param depth how much of the source is added to the destination, a signed Q7n8 number, so 256 adds the source as it is,
+	and -128 subtracts half of it.
+	@return the route's number, for setDepth(), or -1 if there are already MAX_ROUTES routes.
+	*/
+	int8_t addRoute(uint8_t source, uint8_t destination, int depth)
+	{
+		if (num_routes >= MAX_ROUTES) return -1;
+		uint8_t r = num_routes++;
+		route_sources[r] = source;
+		route_destinations[r] = destination;
+		contributions[r] = 0;
+		setDepth(r, depth);
+		return r;
+	}
+
+
+	/** Change the depth of a route.
+	@param route the number addRoute() gave.
+	@param depth how much of the source is added to the destination, a signed Q7n8 number.
+	*/
+	inline
+	void setDepth(uint8_t route, int depth)
+	{
+		depths[route] = depth;
+		source_changed[route_sources[route]] = true; // so update() works the route out again
+	}
+
+
+	/** Give a source its latest value, for instance from an LFOBank's value() or an ADSR's next().
+	@param source which source, from 0 to NUM_SOURCES-1.
+	@param value the source's value.
+	*/
+	inline
+	void setSource(uint8_t source, int value)
+	{
+		if (value != sources[source])
+		{
+			sources[source] = value;
+			source_changed[source] = true;
+		}
+	}
+
+
+	/** Work out the destinations which have changed, and call their setters if their values are different.
+	Call this once in updateControl(), after setting the sources.
+	*/
+	void update()
+	{
+		for (uint8_t r = 0; r < num_routes; ++r)
+		{
+			if (!source_changed[route_sources[r]]) continue;
+			int32_t contribution = ((int32_t) sources[route_sources[r]] * depths[r]) >> 8;
+			uint8_t d = route_destinations[r];
+			sums[d] += contribution - contributions[r];
+			contributions[r] = contribution;
+			if (destination_changed[d] == UNCHANGED) destination_changed[d] = CHANGED;
+		}
+		for (uint8_t s = 0; s < NUM_SOURCES; ++s) source_changed[s] = false;
+
+		for (uint8_t d = 0; d < NUM_DESTINATIONS; ++d)
+		{
+			if (destination_changed[d] == UNCHANGED) continue;
+			int32_t v = sums[d] + bases[d];
+			if (v < minimums[d]) v = minimums[d];
+			if (v > maximums[d]) v = maximums[d];
+			if ((int) v != outputs[d] || destination_changed[d] == RESEND)
+			{
+				outputs[d] = (int) v;
+				if (setters[d]) setters[d](outputs[d]);
+			}
+			destination_changed[d] = UNCHANGED;
+		}
+	}
+
+
+	/** The value of a destination, as it was at the last update().
+	@param destination which destination, from 0 to NUM_DESTINATIONS-1.
+	@return the base with the modulation added, within the destination's range.
+	*/
+	inline
+	int value(uint8_t destination) const
+	{
+		return outputs[destination];
+	}
+
+
+private:
+	enum {UNCHANGED, CHANGED, RESEND};
+
+	// the sources
+	int sources[NUM_SOURCES];
+	bool source_changed[NUM_SOURCES];
+
+	// the routes
+	uint8_t num_routes;
+	uint8_t route_sources[MAX_ROUTES];
+	uint8_t route_destinations[MAX_ROUTES];
+	int depths[MAX_ROUTES];
+	int32_t contributions[MAX_ROUTES]; // the last source * depth, kept so the sums can be updated with the difference
+
+	// the destinations
+	setter_t setters[NUM_DESTINATIONS];
+	int bases[NUM_DESTINATIONS];
+	int32_t sums[NUM_DESTINATIONS];
+	int minimums[NUM_DESTINATIONS], maximums[NUM_DESTINATIONS];
+	int outputs[NUM_DESTINATIONS];
+	uint8_t destination_changed[NUM_DESTINATIONS];
+};
+
+/**
+@example 06.Synthesis/ModMatrix/ModMatrix.ino
+This example demonstrates the LFOBank and ModMatrix classes.
+*/
+
+#endif /* MODMATRIX_H_ */
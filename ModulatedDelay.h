@@ -0,0 +1,215 @@
+/*
+ * ModulatedDelay.h
+ *
+ * This file is part of Mozzi.
+ *
+ * Copyright 2012-2024 Tim Barrass and the Mozzi Team
+ *
+ * Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+ *
+ */
+
+#ifndef MODULATEDDELAY_H_
+#define MODULATEDDELAY_H_
+
+#include <Arduino.h>
+#include "mozzi_fixmath.h"
+#include "MozziHeadersOnly.h"
+
+
+/** Audio delay line with its delay time swept by a built-in LFO, for chorus, flanger and vibrato effects.
+Each of the NUM_TAPS taps reads the same buffer at its own point in the LFO cycle, spread evenly around it,
+and the reads are linearly interpolated between cells so the delay time slides smoothly at audio rate.
+
+The LFO is a triangle wave calculated from a single phase accumulator, so the taps don't need an Oscil each:
+per tap, each sample costs one 16x16 bit multiply for the delay time, two buffer reads and one small multiply for the interpolation.
+
+For a stereo spread, the taps with even indices go to left() and the odd ones to right(), so an even
+number of taps is best for stereo (2 makes a classic stereo chorus).  With one tap, left() and right() are the same.
+
+Some typical settings at MOZZI_AUDIO_RATE 16384:
+- chorus: 2 or more taps, delay 15 ms, depth 3 ms, LFO 0.3 to 1 Hz, no feedback.
+- flanger: 1 tap, delay 2 ms, depth 2 ms, LFO 0.1 to 0.5 Hz, feedback around 100 (or -100 for a hollower sound).
+- vibrato: 1 tap, delay 3 ms, depth 2 ms, LFO 4 to 7 Hz, and use only the delayed signal.
+
+@tparam NUM_BUFFER_SAMPLES is the length of the delay buffer in samples, which must be a power of two.
+It needs to be longer than the delay time plus the depth.  512 is 31 ms at 16384 Hz.
+@tparam NUM_TAPS how many modulated taps read from the delay, 2 by default.
+@tparam T the type of numbers to use for the signal in the delay.  The default is int8_t, int16_t gives better
+quality on boards with more RAM, with the input limited to 15 bits.
+*/
+template <uint16_t NUM_BUFFER_SAMPLES, uint8_t NUM_TAPS = 2, class T = int8_t>
+class ModulatedDelay
+{
+
+	static_assert((NUM_BUFFER_SAMPLES & (NUM_BUFFER_SAMPLES - 1)) == 0, "NUM_BUFFER_SAMPLES must be a power of two");
+	static_assert(NUM_TAPS > 0, "ModulatedDelay needs at least one tap");
+
+public:
+
+	/** Constructor.
+	*/
+	ModulatedDelay(): write_pos(0), _delay_cells(0), _depth_cells(0), lfo_phase(0), lfo_phase_inc(0), _feedback_level(0), last_tap(0), _left(0), _right(0)
+	{
+		for (uint16_t i = 0; i < NUM_BUFFER_SAMPLES; ++i) delay_array[i] = 0;
+	}
+
+
+	/** Input a value to the delay and retrieve the sum of all the modulated taps.
+	The separate left and right sums for the same sample can be read afterwards with left() and right().
+	@param input the signal input.
+	@return the sum of the taps, so it's NUM_TAPS times as large as the input at most.
+	*/
+	inline
+	int next(int input)
+	{
+		int32_t in = input + (((int32_t) last_tap * _feedback_level) >> 7);
+		++write_pos &= (NUM_BUFFER_SAMPLES - 1);
+		delay_array[write_pos] = (T) constrain(in, -(1L << ((sizeof(T) << 3) - 1)), (1L << ((sizeof(T) << 3) - 1)) - 1);
+
+		lfo_phase += lfo_phase_inc;
+
+		int sum_left = 0, sum_right = 0;
+		for (uint8_t i = 0; i < NUM_TAPS; ++i)
+		{
+			uint16_t phase = (uint16_t) ((lfo_phase + i * TAP_PHASE_SPACING) >> 16);
+			uint16_t tri = (phase & 0x8000) ? (uint16_t) ~(phase << 1) : (uint16_t) (phase << 1);
+			Q16n16 delay_cells = _delay_cells + (uint32_t) tri * _depth_cells;
+
+			uint16_t read_pos = (write_pos - (uint16_t) (delay_cells >> 16)) & (NUM_BUFFER_SAMPLES - 1);
+			int a = delay_array[read_pos];
+			int b = delay_array[(read_pos - 1) & (NUM_BUFFER_SAMPLES - 1)]; // one cell older
+			int tap = a + (int) (((int32_t) (b - a) * (uint8_t) (delay_cells >> 8)) >> 8);
+
+			if (i == 0) last_tap = tap;
+			if (i & 1) sum_right += tap;
+			else sum_left += tap;
+		}
+		_left = sum_left;
+		_right = (NUM_TAPS == 1) ? sum_left : sum_right;
+		return sum_left + sum_right;
+	}
+
+
+	/** The sum of the even-numbered taps for the last sample calculated by next().
+	@return the left output.
+	*/
+	inline
+	int left()
+	{
+		return _left;
+	}
+
+
+	/** The sum of the odd-numbered taps for the last sample calculated by next(), or the same as left() if there's only one tap.
+	@return the right output.
+	*/
+	inline
+	int right()
+	{
+		return _right;
+	}
+
+
+	/** Set the shortest delay time, in cells.  The taps sweep from here up to here plus the depth.
+	@param delay_cells the delay time as a Q16n16 number of cells, which will be limited to fit in the buffer with the depth.
+	*/
+	inline
+	void setDelayCells(Q16n16 delay_cells)
+	{
+		_delay_cells = delay_cells;
+		limit();
+	}
+
+
+	/** Set the shortest delay time, in milliseconds.  This uses floats so it's best called in setup() or only when the setting changes.
+	@param milliseconds the delay time.
+	*/
+	inline
+	void setDelayMs(float milliseconds)
+	{
+		setDelayCells(float_to_Q16n16(milliseconds * MOZZI_AUDIO_RATE / 1000));
+	}
+
+
+	/** Set how far the LFO sweeps the delay time, in cells.
+	@param depth_cells how many cells the taps sweep over, which will be limited to fit in the buffer after the delay time.
+	*/
+	inline
+	void setDepthCells(uint16_t depth_cells)
+	{
+		_depth_cells = depth_cells;
+		limit();
+	}
+
+
+	/** Set how far the LFO sweeps the delay time, in milliseconds.  This uses floats so it's best called in setup() or only when the setting changes.
+	@param milliseconds the depth of the sweep.
+	*/
+	inline
+	void setDepthMs(float milliseconds)
+	{
+		setDepthCells((uint16_t) (milliseconds * MOZZI_AUDIO_RATE / 1000));
+	}
+
+
+	/** Set the LFO frequency.
+	@param frequency the LFO rate in Hz.
+	*/
+	inline
+	void setLFOFreq(float frequency)
+	{
+		lfo_phase_inc = (uint32_t) (frequency * (4294967296.f / MOZZI_AUDIO_RATE));
+	}
+
+
+	/** Set the LFO frequency with a Q16n16 fixed-point number, for up to 255 Hz.
+	@param frequency the LFO rate in Hz as a Q16n16.
+	*/
+	inline
+	void setLFOFreq_Q16n16(Q16n16 frequency)
+	{
+		lfo_phase_inc = (frequency << 8) / (MOZZI_AUDIO_RATE >> 8);
+	}
+
+
+	/** Set how much of the first tap is fed back into the delay.  Feedback gives the resonant "jet" sound of a flanger.
+	@param feedback_level is the feedback level from -128 to 127 (representing -1 to 1).
+	*/
+	inline
+	void setFeedbackLevel(int8_t feedback_level)
+	{
+		_feedback_level = feedback_level;
+	}
+
+
+private:
+	static const uint32_t TAP_PHASE_SPACING = (uint32_t) (4294967296ULL / NUM_TAPS);
+
+	T delay_array[NUM_BUFFER_SAMPLES];
+	uint16_t write_pos;
+	Q16n16 _delay_cells;
+	uint16_t _depth_cells;
+	uint32_t lfo_phase;
+	uint32_t lfo_phase_inc;
+	int8_t _feedback_level;
+	int last_tap;
+	int _left, _right;
+
+
+	// keep the longest delay, plus the extra cell for interpolation, inside the buffer
+	inline
+	void limit()
+	{
+		const Q16n16 max_delay = (Q16n16) (NUM_BUFFER_SAMPLES - 2) << 16;
+		if (_depth_cells > NUM_BUFFER_SAMPLES - 2) _depth_cells = NUM_BUFFER_SAMPLES - 2;
+		if (_delay_cells + ((Q16n16) _depth_cells << 16) > max_delay) _delay_cells = max_delay - ((Q16n16) _depth_cells << 16);
+	}
+};
+
+/**
+@example 09.Delays/ModulatedDelay_Chorus/ModulatedDelay_Chorus.ino
+This example demonstrates the ModulatedDelay class.
+*/
+
+#endif        //  #ifndef MODULATEDDELAY_H_
@@ -16,9 +16,33 @@
 #include "mozzi_fixmath.h"
 #include "Line.h"
 
-/** A simple portamento (pitch slide from one note to the next) effect, useful for note-based applications.
+/** How a Portamento slides between notes, set with its template parameter.
 */
+enum portamento_modes {PORTAMENTO_FREQUENCY, /**< in a straight line in frequency, which is quicker at the bottom of an upward slide */
+	PORTAMENTO_PITCH /**< in a straight line in pitch, at the same number of semitones each step */
+};
+
+
+namespace MozziPrivate {
+
+// copied from ADSR.h, for both kinds of Portamento
 template <unsigned int CONTROL_UPDATE_RATE>
+inline
+unsigned int portamentoMsecToControlSteps(unsigned int msec){
+	return (uint16_t) (((uint32_t)msec*CONTROL_UPDATE_RATE)>>10); // approximate /1000 with shift
+}
+
+}
+
+
+/** A simple portamento (pitch slide from one note to the next) effect, useful for note-based applications.
+@tparam CONTROL_UPDATE_RATE how often next() is called, usually MOZZI_CONTROL_RATE.
+@tparam MODE PORTAMENTO_FREQUENCY, the default, slides in a straight line in frequency, converting each note
+to a frequency with Q16n16_mtof() and starting a Line, which divides.
+PORTAMENTO_PITCH slides in a straight line in note numbers, which sounds even, going up or down,
+and starts each note with a multiply, converting the sliding note to a frequency with Q16n16_mtofExponential() each step.
+*/
+template <unsigned int CONTROL_UPDATE_RATE, uint8_t MODE = PORTAMENTO_FREQUENCY>
 class
 	Portamento {
 	
@@ -37,7 +61,7 @@ public:
 	inline
 	void setTime(unsigned int milliseconds){
 		//control_steps_per_portamento = ((long)milliseconds*1000)/MICROS_PER_CONTROL_STEP; // more accurate but slower
-		control_steps_per_portamento = convertMsecToControlSteps(milliseconds);
+		control_steps_per_portamento = MozziPrivate::portamentoMsecToControlSteps<CONTROL_UPDATE_RATE>(milliseconds);
 	}
 
 	/** Call this at note-on, it initialises the portamento.
@@ -89,18 +113,91 @@ public:
 	const unsigned int MICROS_PER_CONTROL_STEP;
 	Line <Q16n16> aPortamentoLine;
 
-	
-	// copied from ADSR.h
+};
+
+
+// no need to show the specialisations
+/** @cond  */
+
+/** PORTAMENTO_PITCH specialisation of Portamento, which slides in note numbers.
+*/
+template <unsigned int CONTROL_UPDATE_RATE>
+class Portamento <CONTROL_UPDATE_RATE, PORTAMENTO_PITCH>
+{
+
+public:
+
+	/** Constructor.
+	 */
+	Portamento(): countdown(0), control_steps_per_portamento(0), reciprocal(0), note(0), target_note(0), step(0)
+	{
+	}
+
+	/** Set how long it will take to slide from note to note, in milliseconds.
+	@param milliseconds
+	@note This divides, once, so that start() doesn't have to.
+	*/
+	inline
+	void setTime(unsigned int milliseconds){
+		control_steps_per_portamento = MozziPrivate::portamentoMsecToControlSteps<CONTROL_UPDATE_RATE>(milliseconds);
+		reciprocal = control_steps_per_portamento ? 65536UL / control_steps_per_portamento : 0; // Q0n16, or 1.0
+	}
+
+	/** Call this at note-on, it initialises the portamento.
+	@param note a midi note number, a whole number.
+	*/
 	inline
-	static const unsigned int convertMsecToControlSteps(unsigned int msec){
-		return (uint16_t) (((uint32_t)msec*CONTROL_UPDATE_RATE)>>10); // approximate /1000 with shift
+	void start(uint8_t note) {
+		start(Q8n0_to_Q16n16(note));
 	}
 
+	/** Call this at note-on, it initialises the portamento.
+	@param midi_note a midi note number in Q16n16 fractional format.  This is useful for non-whole note or detuned values.
+	*/
+	inline
+	void start(Q16n16 midi_note) {
+		target_note = midi_note;
+		countdown = control_steps_per_portamento;
+		// (target - note) / steps, as a Q16n8 difference times the Q0n16 reciprocal, so it fits in 32 bits
+		step = ((int32_t) (target_note - note) >> 8) * (int32_t) reciprocal >> 8;
+		if (!countdown) note = target_note;
+	}
+
+
+	/** Use this in updateControl() to provide a frequency to the oscillator it's controlling.
+	For example:
+	myOscil.setFreq_Q16n16(myPortamento.next());
+	@return a Q16n16 fractional frequency value, progressing smoothly between successive notes.
+	*/
+	inline
+	Q16n16 next() {
+		if (countdown) {
+			// land exactly on the note, whatever the rounding of the step
+			note = (--countdown) ? note + step : target_note;
+		}
+		return Q16n16_mtofExponential(note);
+	}
+
+	private:
+
+	unsigned int countdown;
+	unsigned int control_steps_per_portamento;
+	uint32_t reciprocal;
+	Q16n16 note, target_note; // midi notes, with fractions
+	int32_t step;
+
 };
 
+/** @endcond */
+
 /**
 @example 05.Control_Filters/Teensy_USB_MIDI_portamento/Teensy_USB_MIDI_portamento.ino
 This example demonstrates the Portamento class.
 */
 
+/**
+@example 05.Control_Filters/Portamento_Pitch/Portamento_Pitch.ino
+This example demonstrates Portamento sliding in pitch.
+*/
+
 #endif /* PORTAMENTO_H_ */
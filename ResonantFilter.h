@@ -15,6 +15,9 @@
 #include "IntegerType.h"
 #include "AudioOutput.h"
 #include "meta.h"
+#include "mozzi_pgmspace.h"
+#include "tables/twosinpi257_uint16.h"
+#include "Line.h"
 
 
 
@@ -69,6 +72,32 @@ fixed point version of the filter
 
 enum filter_types { LOWPASS, BANDPASS, HIGHPASS, NOTCH };
 
+
+// interpolate a table of 257 cells covering 0 to MOZZI_AUDIO_RATE/4, at a frequency in Hz
+inline uint16_t filterTableFromHz(const uint16_t * table, uint16_t freq)
+{
+  // 256 cells cover 0 to MOZZI_AUDIO_RATE/4, so this gives the cell as Q8n16
+  const uint32_t CELLS_PER_HZ = (1024UL << 16) / MOZZI_AUDIO_RATE;
+  uint32_t cell = (uint32_t) freq * CELLS_PER_HZ;
+  if (cell >= (256UL << 16)) return FLASH_OR_RAM_READ<const uint16_t>(table + 256);
+  uint8_t index = cell >> 16;
+  uint8_t fraction = cell >> 8;
+  uint16_t a = FLASH_OR_RAM_READ<const uint16_t>(table + index);
+  uint16_t b = FLASH_OR_RAM_READ<const uint16_t>(table + index + 1);
+  return a + (((uint32_t) (b - a) * fraction) >> 8);
+}
+
+/** Convert a frequency in Hz to the filter coefficient 2*sin(pi*freq/MOZZI_AUDIO_RATE), used by
+ResonantFilter::setCutoffHz() and StateVariable::setCentreFreqHz().
+It interpolates a table made for any audio rate, so it costs two table reads and two multiplies instead of a sin().
+@param freq the frequency in Hz, up to MOZZI_AUDIO_RATE/4.  Higher frequencies give the value at MOZZI_AUDIO_RATE/4.
+@return the coefficient as a Q1n15 number in a uint16_t, where 32768 represents 1.0.
+*/
+inline uint16_t Q1n15_filterCoeffFromHz(uint16_t freq)
+{
+  return filterTableFromHz(TWOSINPI257_DATA, freq);
+}
+
 /** A generic resonant filter for audio signals.
  */
 template<int8_t FILTER_TYPE, typename su=uint8_t>
@@ -119,6 +148,25 @@ public:
     fb = q + ucfxmul(q,(typename IntegerType<sizeof(su)+sizeof(su)>::unsigned_type) SHIFTED_1 + cutoff);
   }
 
+  /** Set the cut off frequency in Hz, keeping the resonance set by setResonance() or setCutoffHzAndResonance().
+  The frequency is converted to the filter's cutoff with 2*sin(pi*freq/MOZZI_AUDIO_RATE), using a table
+  (see Q1n15_filterCoeffFromHz()), so this is fast enough to call at every control update for filter envelopes.
+  @param cutoff_hz the cutoff frequency in Hz.  The filter's cutoff reaches its maximum at MOZZI_AUDIO_RATE/6.
+  */
+  void setCutoffHz(uint16_t cutoff_hz)
+  {
+    setCutoffFreq(cutoffFromHz(cutoff_hz));
+  }
+
+  /** Set the cut off frequency in Hz and the resonance.
+  @param cutoff_hz the cutoff frequency in Hz, see setCutoffHz().
+  @param resonance range 0-255 for ResonantFilter, 0-65535 for ResonantFilter<FILTER_TYPE, uint16_t>, 255/65535 is most resonant.
+  */
+  void setCutoffHzAndResonance(uint16_t cutoff_hz, su resonance)
+  {
+    setCutoffFreqAndResonance(cutoffFromHz(cutoff_hz), resonance);
+  }
+
   /** Calculate the next sample, given an input signal.
   @param in the signal input. Should not be more than 8bits on 8bits platforms (Arduino) if using the 8bits version and not 16bits version.
   @return the signal output.
@@ -147,6 +195,14 @@ protected:
   // 	return (a*b)>>FX_SHIFT;
   // }
 
+  // the Q1n15 coefficient for a frequency, scaled to su where SHIFTED_1 is 1.0
+  inline su cutoffFromHz(uint16_t cutoff_hz)
+  {
+    uint16_t coeff = Q1n15_filterCoeffFromHz(cutoff_hz);
+    if (coeff >= 32768) return SHIFTED_1;
+    return (FX_SHIFT > 15) ? (su) ((typename IntegerType<sizeof(su)+sizeof(su)>::unsigned_type) coeff << (FX_SHIFT - 15)) : (su) (coeff >> (15 - FX_SHIFT));
+  }
+
   inline void advanceBuffers(AudioOutputStorage_t in)
   {
     buf0 += fxmul(((in - buf0) + fxmul(fb, buf0 - buf1)), f);
@@ -214,6 +270,123 @@ private:
 };
 
 
+/** A ResonantFilter whose cutoff can be swept smoothly at audio rate.
+Instead of setting the cutoff once per control update, which steps audibly on fast sweeps,
+setCutoffTarget() ramps the cutoff to a new value over a number of audio samples.
+The feedback amount depends linearly on the cutoff, so both are ramped with a Line, the same way
+WavePacket interpolates its controls, and each sample costs two additions on top of ResonantFilter::next(),
+with no multiply to recalculate the feedback.
+Typically setCutoffTarget() is called in updateControl() with MOZZI_AUDIO_RATE/MOZZI_CONTROL_RATE steps, so the cutoff arrives
+just as the next control update sets a new target.  When a ramp finishes, the cutoff stays at the target.
+@tparam FILTER_TYPE choose between LOWPASS, BANDPASS, HIGHPASS and NOTCH.
+@tparam su the type used for the cutoff and resonance, uint8_t (default) or uint16_t, as for ResonantFilter.
+ */
+template<int8_t FILTER_TYPE, typename su=uint8_t>
+class ModulatedResonantFilter: public ResonantFilter<FILTER_TYPE,su>
+{
+public:
+  /** Constructor.
+   */
+  ModulatedResonantFilter(): remaining_steps(0) { ; }
+
+  /** Set the cut off frequency immediately, stopping any ramp in progress.
+  @param cutoff range 0-255 for the 8 bit version, 0-65535 for the 16 bit version, as for ResonantFilter::setCutoffFreq().
+  */
+  void setCutoffFreq(su cutoff)
+  {
+    ResonantFilter<FILTER_TYPE,su>::setCutoffFreq(cutoff);
+    remaining_steps = 0;
+  }
+
+  /** Set the cut off frequency and resonance immediately, stopping any ramp in progress.
+  @param cutoff range 0-255 for the 8 bit version, 0-65535 for the 16 bit version.
+  @param resonance range 0-255 for the 8 bit version, 0-65535 for the 16 bit version, 255/65535 is most resonant.
+  */
+  void setCutoffFreqAndResonance(su cutoff, su resonance)
+  {
+    ResonantFilter<FILTER_TYPE,su>::setCutoffFreqAndResonance(cutoff, resonance);
+    remaining_steps = 0;
+  }
+
+  /** Set the cut off frequency in Hz immediately, stopping any ramp in progress, see ResonantFilter::setCutoffHz().
+  @param cutoff_hz the cutoff frequency in Hz.
+  */
+  void setCutoffHz(uint16_t cutoff_hz)
+  {
+    setCutoffFreq(this->cutoffFromHz(cutoff_hz));
+  }
+
+  /** Set the cut off frequency in Hz and the resonance immediately, stopping any ramp in progress.
+  @param cutoff_hz the cutoff frequency in Hz, see setCutoffHz().
+  @param resonance range 0-255 for the 8 bit version, 0-65535 for the 16 bit version, 255/65535 is most resonant.
+  */
+  void setCutoffHzAndResonance(uint16_t cutoff_hz, su resonance)
+  {
+    setCutoffFreqAndResonance(this->cutoffFromHz(cutoff_hz), resonance);
+  }
+
+  /** Ramp the cutoff from where it is now to a new value, a little more at every sample.
+  The resonance set by setResonance() or setCutoffFreqAndResonance() is used for the whole ramp.
+  @param cutoff the cutoff to arrive at, in the same range as setCutoffFreq().
+  @param num_steps how many audio samples the ramp takes.  0 sets the cutoff immediately.
+  */
+  void setCutoffTarget(su cutoff, uint16_t num_steps)
+  {
+    if (num_steps == 0) {
+      setCutoffFreq(cutoff);
+      return;
+    }
+    target_f = cutoff;
+    target_fb = feedbackFor(cutoff);
+    f_line.set((int32_t) this->f << F_BITS, (int32_t) target_f << F_BITS, (int32_t) num_steps);
+    fb_line.set((int32_t) this->fb << F_BITS, (int32_t) target_fb << F_BITS, (int32_t) num_steps);
+    remaining_steps = num_steps;
+  }
+
+  /** Ramp the cutoff to a new frequency in Hz, see setCutoffTarget() and ResonantFilter::setCutoffHz().
+  @param cutoff_hz the cutoff frequency to arrive at, in Hz.
+  @param num_steps how many audio samples the ramp takes.
+  */
+  void setCutoffHzTarget(uint16_t cutoff_hz, uint16_t num_steps)
+  {
+    setCutoffTarget(this->cutoffFromHz(cutoff_hz), num_steps);
+  }
+
+  /** Calculate the next sample, moving one step along any cutoff ramp.
+  @param in the signal input, as for ResonantFilter::next().
+  @return the signal output.
+  */
+  inline AudioOutputStorage_t next(AudioOutputStorage_t in)
+  {
+    if (remaining_steps) {
+      if (--remaining_steps) {
+        this->f = f_line.next() >> F_BITS;
+        this->fb = fb_line.next() >> F_BITS;
+      } else { // land exactly on the target
+        this->f = target_f;
+        this->fb = target_fb;
+      }
+    }
+    return ResonantFilter<FILTER_TYPE,su>::next(in);
+  }
+
+private:
+  // fractional bits for the ramps, leaving room for fb, which can be nearly three times the largest su
+  static const uint8_t F_BITS = 29 - (sizeof(su) << 3);
+
+  Line <int32_t> f_line;
+  Line <int32_t> fb_line;
+  su target_f;
+  typename IntegerType<sizeof(su)+sizeof(su)>::unsigned_type target_fb;
+  uint16_t remaining_steps;
+
+  inline typename IntegerType<sizeof(su)+sizeof(su)>::unsigned_type feedbackFor(su cutoff)
+  {
+    return this->q + this->ucfxmul(this->q, (typename IntegerType<sizeof(su)+sizeof(su)>::unsigned_type) this->SHIFTED_1 + cutoff);
+  }
+};
+
+
 typedef ResonantFilter<LOWPASS> LowPassFilter;
 typedef ResonantFilter<LOWPASS, uint16_t> LowPassFilter16;
 /*
@@ -235,6 +408,9 @@ This example demonstrates the ResonantFilter16 specification of this class.
 
 @example 10.Audio_Filters/MultiResonantFilter/MultiResonantFilter.ino
 This example demonstrates the MultiResonantFilter specification of this class.
+
+@example 10.Audio_Filters/ModulatedResonantFilter/ModulatedResonantFilter.ino
+This example demonstrates the ModulatedResonantFilter specification of this class.
 */
 
 #endif /* RESONANTFILTER_H_ */
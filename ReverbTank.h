@@ -28,6 +28,7 @@ The room size according to the maximum delay lengths corresponds to:
 early reflections and recirculating delay 1: 128/16384 seconds * 340.29 m/s speed of sound = 3.5 metres
 recirculating delay 2: 7 metres
 It looks bigger on paper than it sounds.
+Each ReverbTank keeps its own state, so a stereo reverb can be made with two instances.
 */
 class
 	ReverbTank {
@@ -49,8 +50,8 @@ public:
 	  int8_t loop1_delay=117,
 	  uint8_t loop2_delay=255,
 	  int8_t feedback_level = 85):
-			_early_reflection1(early_reflection1),_early_reflection2(early_reflection3),_early_reflection3(early_reflection3),
-			_feedback_level(feedback_level)
+			_early_reflection1(early_reflection1),_early_reflection2(early_reflection2),_early_reflection3(early_reflection3),
+			_feedback_level(feedback_level), recycle1(0), recycle2(0)
 	{
 		aLoopDel1.set(loop1_delay);
 		aLoopDel2.set(loop2_delay);
@@ -63,8 +64,6 @@ public:
 	@return the processed signal
 	*/
 	int next(int input){
-		static int recycle1, recycle2;
-
 		// early reflections
 		int asig = aLoopDel0.next(input, _early_reflection1);
 		asig += aLoopDel0.read(_early_reflection2);
@@ -83,6 +82,36 @@ public:
 	}
 
 
+	/** Process a block of audio samples and return the reverbed signal for each.  This gives the same
+	result as calling next(int input) for each sample in turn, with the recirculating state kept in local
+	variables for the length of the block.
+	@param input an array of num_samples input values.
+	@param output an array to receive num_samples wet output values.  It may be the same array as input.
+	@param num_samples how many samples to process.
+	*/
+	void next(const int * input, int * output, uint16_t num_samples){
+		int r1 = recycle1;
+		int r2 = recycle2;
+		const int8_t er1 = _early_reflection1, er2 = _early_reflection2, er3 = _early_reflection3;
+		const int8_t feedback_level = _feedback_level;
+		for (uint16_t i = 0; i < num_samples; ++i) {
+			int asig = aLoopDel0.next(input[i], er1);
+			asig += aLoopDel0.read(er2);
+			asig += aLoopDel0.read(er3);
+			asig >>= 2;
+			int8_t feedback_sig1 = (int8_t) min(max(((r1 * feedback_level)>>7),-128),127);
+			int8_t feedback_sig2 = (int8_t) min(max(((r2 * feedback_level)>>7),-128),127);
+			int sig3 = aLoopDel1.next(asig+feedback_sig1);
+			int sig4 = aLoopDel2.next(asig+feedback_sig2);
+			r1 = sig3 + sig4;
+			r2 = sig3 - sig4;
+			output[i] = r1;
+		}
+		recycle1 = r1;
+		recycle2 = r2;
+	}
+
+
 	/** Set the early reflection times in terms of delay cells.
 	@param early_reflection1 how long in delay cells till the first early reflection, from 0 to 127
 	@param early_reflection2 how long in delay cells till the second early reflection, from early_reflection1 to 127
@@ -119,6 +148,9 @@ private:
 
 	int8_t _feedback_level;
 
+	// recirculation state, per instance so two reverbs (eg. left and right) don't share it
+	int recycle1, recycle2;
+
 	AudioDelay <128> aLoopDel0; // 128/16384 seconds * 340.29 m/s speed of sound = 3.5 metres
 	AudioDelay <128,int> aLoopDel1;
 	AudioDelay <256,int> aLoopDel2; // 7 metres
@@ -22,14 +22,46 @@
 #include "mozzi_utils.h" // for trailingZeros()
 
 
+namespace MozziPrivate {
+
+// how many bits it takes to hold v
+constexpr uint8_t bitsNeeded(unsigned long v) { return v ? 1 + bitsNeeded(v >> 1) : 0; }
+
+/* total / N, with a shift if N is a power of two, or else by multiplying by a 16 bit reciprocal,
+2^SHIFT / N rounded up, split into two 16 x 16 bit multiplies so there's no division or 64 bit arithmetic.
+SHIFT is chosen so the reciprocal is between 2^15 and 2^16, which keeps the result within 2 of total / N, rounded down,
+for results of up to 16 bits.  Negative totals are divided as their magnitude and given their sign back,
+as the reciprocal rounded up would take them one further from zero, so a total of a constant input times N
+gives that input back, either way, for results from -32767 to 32767. */
+template <unsigned long N>
+inline long divideByConst(long total)
+{
+	static_assert(N >= 1 && N <= 32768, "the window length must be from 1 to 32768");
+	if ((N & (N - 1)) == 0) return total >> trailingZerosConst(N);
+	const uint8_t SHIFT = 15 + bitsNeeded(N - 1);
+	const unsigned long RECIPROCAL = ((1UL << SHIFT) + N - 1) / N;
+	bool negative = total < 0;
+	unsigned long magnitude = negative ? -(unsigned long) total : (unsigned long) total;
+	uint16_t hi = (uint16_t) (magnitude >> 16);
+	uint16_t lo = (uint16_t) magnitude;
+	long quotient = (long) (((unsigned long) hi * RECIPROCAL + (((unsigned long) lo * RECIPROCAL) >> 16)) >> (SHIFT - 16));
+	return negative ? -quotient : quotient;
+}
+
+}
+
+
+
 /** @ingroup sensortools
   Calculates a running average over a 
   specified number of the most recent readings.  
   Like Smooth(), this is good for smoothing analog inputs in updateControl().
   @tparam WINDOW_LENGTH the number of readings to include in the rolling average.
-   It must be a power of two (unless you're averaging floats). The higher the
-   number, the more the readings will be smoothed, but the slower the output
+   A power of two is quickest, as the average is then found with a shift, but other lengths up to 32768 work too,
+   dividing by multiplying with a reciprocal, which is accurate to within 2 for averages of up to 16 bits.
+   The higher the number, the more the readings will be smoothed, but the slower the output
    will respond to the input.
+   DecimatingAverage gives one average for each WINDOW_LENGTH readings instead, without storing them.
 */ 
 
 template <class T, int WINDOW_LENGTH>
@@ -42,12 +74,12 @@ public:
 	@tparam T the type of numbers to average, eg. int, unsigned int, float etc.  It will be relatively slow with
 	floating point numbers, as it will use a divide operation for the averaging.
 	Nevertheless, there might be a time when it's useful.
-	@tparam WINDOW_LENGTH the number of readings to keep track of. It must be a power of two (unless
-	you're averaging floats). The higher the number, the more the readings will be
+	@tparam WINDOW_LENGTH the number of readings to keep track of, up to 32768.  A power of two is quickest.
+	The higher the number, the more the readings will be
 	smoothed, but the slower the output will respond to the input.
 	@note Watch out for overflows!
 	*/
-	RollingAverage():index(0),total(0), WINDOW_LENGTH_AS_RSHIFT(trailingZerosConst(WINDOW_LENGTH))
+	RollingAverage():index(0),total(0)
 	{
 		// initialize all the readings to 0:
 		for (int thisReading = 0; thisReading < WINDOW_LENGTH; thisReading++)
@@ -62,7 +94,8 @@ public:
 	*/
 	T next(T input)
 	{
-		return add(input)>>WINDOW_LENGTH_AS_RSHIFT;
+		add(input);
+		return MozziPrivate::divideByConst<WINDOW_LENGTH>(total);
 	}
 
 
@@ -77,7 +110,7 @@ protected:
 		readings[index] = input;
 
 		// advance and wrap index
-		++index &= WINDOW_LENGTH -1;
+		if (++index == WINDOW_LENGTH) index = 0;
 		return total;
 	}
 		
@@ -86,7 +119,6 @@ private:
 	T readings[WINDOW_LENGTH];	// the readings from the analog input
 	unsigned int index;	// the index of the current reading
 	long total;	// the running total
-	const uint8_t WINDOW_LENGTH_AS_RSHIFT;
 	
 };
 
@@ -101,13 +133,13 @@ class RollingAverage <unsigned int, WINDOW_LENGTH>
 {
 public:
 	/** Constructor.
-	@tparam WINDOW_LENGTH A power of two, the number of readings to keep track of.    
+	@tparam WINDOW_LENGTH the number of readings to keep track of.    
 	The higher the number, the more the readings will be smoothed, but the slower the output will
 	respond to the input. 
 	@note The internal total of all the values being averaged is held in a long (4 uint8_t) integer, to avoid overflowing.
 	However, watch out for overflows if you are averaging a long number types!
 	*/
-	RollingAverage():index(0),total(0), WINDOW_LENGTH_AS_RSHIFT(trailingZerosConst(WINDOW_LENGTH))
+	RollingAverage():index(0),total(0)
 	{
 		// initialize all the readings to 0:
 		for (int thisReading = 0; thisReading < WINDOW_LENGTH; thisReading++)
@@ -122,9 +154,9 @@ public:
 	unsigned int next(unsigned int input)
 	{
 		// calculate the average:
-		// this unsigned cast is the only difference between the int and unsigned int specialisations
-		// it tells the shift not to sign extend in from the left
-		return (unsigned)add(input)>>WINDOW_LENGTH_AS_RSHIFT;
+		// total is never negative here, so the shift in divideByConst() doesn't sign extend in from the left
+		add(input);
+		return (unsigned int) MozziPrivate::divideByConst<WINDOW_LENGTH>(total);
 	}
 
 protected:
@@ -139,7 +171,7 @@ protected:
 		readings[index] = input;
 
 		// advance and wrap index
-		++index &= WINDOW_LENGTH -1;
+		if (++index == WINDOW_LENGTH) index = 0;
 		return total;
 	}
 	
@@ -148,7 +180,6 @@ private:
 	unsigned int readings[WINDOW_LENGTH];      // the readings from the analog input
 	unsigned int index;                  // the index of the current reading
 	long total;               // the running total
-	const uint8_t WINDOW_LENGTH_AS_RSHIFT;
 
 };
 
@@ -160,7 +191,7 @@ class RollingAverage <float, WINDOW_LENGTH>
 {
 public:
 	/** Constructor.
-	@tparam WINDOW_LENGTH A power of two, the number of readings to keep track of.    
+	@tparam WINDOW_LENGTH the number of readings to keep track of.    
 	The higher the number, the more the readings will be smoothed, but the slower the output will
 	respond to the input. 
 	@note The internal total of all the values being averaged is held in a long (4 uint8_t) integer, to avoid overflowing.
@@ -187,7 +218,7 @@ public:
 		readings[index] = input;
 
 		// advance and wrap index
-		++index &= WINDOW_LENGTH -1;
+		if (++index == WINDOW_LENGTH) index = 0;
 
 		// calculate the average:
 		return total/WINDOW_LENGTH;
@@ -205,9 +236,95 @@ private:
 /** @endcond 
 */
 
+
+/** @ingroup sensortools
+  Averages each block of WINDOW_LENGTH readings, giving one new average per block rather than one for every reading.
+  This is a boxcar filter followed by decimation by WINDOW_LENGTH, or a first order CIC filter:
+  the readings are added up, and when WINDOW_LENGTH of them have gone in, the total is divided by WINDOW_LENGTH
+  and cleared.  Nothing but the total is stored, so it takes the same few bytes of RAM for any window length,
+  where RollingAverage keeps every reading in the window.
+  It suits sensors read more often than their value is needed, for instance several
+  mozziAnalogRead() inputs read each updateControl() and used every few control steps.
+  OverSample does the same kind of summing for extra resolution, with getSum() here giving the undivided total.
+  @tparam T the type of numbers to average, int, unsigned int, int8_t or uint8_t.
+  @tparam WINDOW_LENGTH the number of readings in each average, up to 32768.  A power of two is quickest,
+  but any length works, as in RollingAverage.
+  @note The total is held in a long, so WINDOW_LENGTH times the largest reading has to fit in that.
+*/
+template <class T, unsigned int WINDOW_LENGTH>
+class DecimatingAverage
+{
+public:
+	/** Constructor.  The average is 0 until the first window is complete.
+	*/
+	DecimatingAverage(): count(0), total(0), sum(0), average(0)
+	{}
+
+
+	/** Add a reading to the current window.
+	@param input a control signal such as an analog input.
+	@return true if this reading completed a window, so there is a new average to get().
+	*/
+	inline
+	bool update(T input)
+	{
+		total += input;
+		if (++count < WINDOW_LENGTH) return false;
+		sum = total;
+		average = (T) MozziPrivate::divideByConst<WINDOW_LENGTH>(total);
+		total = 0;
+		count = 0;
+		return true;
+	}
+
+
+	/** Add a reading, and give the average of the last complete window.
+	@param input a control signal such as an analog input.
+	@return the average of the last complete window, which only changes once every WINDOW_LENGTH readings.
+	*/
+	inline
+	T next(T input)
+	{
+		update(input);
+		return average;
+	}
+
+
+	/** The average of the last complete window.
+	@return the average.
+	*/
+	inline
+	T get() const
+	{
+		return average;
+	}
+
+
+	/** The total of the readings in the last complete window, before dividing, for more resolution than the average.
+	@return the total.
+	*/
+	inline
+	long getSum() const
+	{
+		return sum;
+	}
+
+
+private:
+	unsigned int count;
+	long total;
+	long sum;
+	T average;
+};
+
 /**
 @example 03.Sensors/Knob_LDR_x2_WavePacket/Knob_LDR_x2_WavePacket.ino
 This example demonstrates the RollingAverage class.
 */
 
+/**
+@example 05.Control_Filters/DecimatingAverage/DecimatingAverage.ino
+This example demonstrates the DecimatingAverage class.
+*/
+
 #endif        //  #ifndef ROLLINGAVERAGE_H
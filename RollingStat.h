@@ -7,83 +7,243 @@
  *
  * Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
  *
- * WARNING: this code is incomplete, it doesn't work yet
  */
 
 #ifndef ROLLINGSTAT_H
 #define ROLLINGSTAT_H
 
-#include "RollingAverage.h"
+#include "mozzi_utils.h"
 #include "mozzi_fixmath.h"
+#include "IntegerType.h"
+
+
+namespace MozziPrivate {
+
+/* The last WINDOW_LENGTH inputs, in a ring, with the positions of the window's minimum and maximum in two monotonic deques.
+The maximum deque holds the positions of the inputs which are bigger than every later one, oldest first,
+so its front is the window's maximum: each new input removes the ones at the back which it is at least as big as,
+and the front leaves when its input drops out of the window.  Every position goes in and out once,
+so this takes constant time for each input, on average.  The minimum deque is the same the other way round.
+The window starts full of zeros, which the deques stand for with just the last one. */
+template <class T, int WINDOW_LENGTH>
+class RollingWindow
+{
+
+	static_assert(WINDOW_LENGTH >= 2 && WINDOW_LENGTH <= 32768 && (WINDOW_LENGTH & (WINDOW_LENGTH - 1)) == 0, "WINDOW_LENGTH must be a power of two");
+
+public:
+	RollingWindow(): index(0), max_head(0), max_tail(1), min_head(0), min_tail(1)
+	{
+		for (int i = 0; i < WINDOW_LENGTH; ++i) readings[i] = 0;
+		max_q[0] = min_q[0] = WINDOW_LENGTH - 1;
+	}
+
+
+	// put x in the window, and return the input it pushes out
+	inline
+	T add(T x)
+	{
+		T old = readings[index];
+		// the oldest input is leaving, so if it's the front of a deque, that goes too
+		if (max_q[max_head & MASK] == index) ++max_head;
+		if (min_q[min_head & MASK] == index) ++min_head;
+		while (max_tail != max_head && readings[max_q[(max_tail - 1) & MASK]] <= x) --max_tail;
+		max_q[max_tail++ & MASK] = index;
+		while (min_tail != min_head && readings[min_q[(min_tail - 1) & MASK]] >= x) --min_tail;
+		min_q[min_tail++ & MASK] = index;
+		readings[index] = x;
+		index = (index + 1) & MASK;
+		return old;
+	}
+
+
+	// the input i places after the oldest, once add() has returned
+	inline
+	T get(unsigned int i) const
+	{
+		return readings[(index + i) & MASK];
+	}
+
+
+	// whether the last add() filled the last place in the ring, so the oldest input is at the start again
+	inline
+	bool wrapped() const
+	{
+		return index == 0;
+	}
+
+
+	inline
+	T getMin() const
+	{
+		return readings[min_q[min_head & MASK]];
+	}
+
+
+	inline
+	T getMax() const
+	{
+		return readings[max_q[max_head & MASK]];
+	}
+
+
+private:
+	static const unsigned int MASK = WINDOW_LENGTH - 1;
+	typedef typename IntegerType<(WINDOW_LENGTH > 256) ? 2 : 1>::unsigned_type position_t;
+
+	T readings[WINDOW_LENGTH];
+	position_t max_q[WINDOW_LENGTH], min_q[WINDOW_LENGTH];
+	unsigned int index, max_head, max_tail, min_head, min_tail;
+};
+
+
+/* The types RollingStat keeps the sum of its inputs and returns the variance in, wider for 32 bit inputs,
+with the integer square root for each. */
+template <bool WIDE>
+struct RollingStatTypes
+{
+	typedef long total_t;
+	typedef unsigned long variance_t;
+
+	static inline
+	variance_t root(variance_t v)
+	{
+		return (v <= 65535) ? isqrt16((uint16_t) v) : isqrt32((uint32_t) v);
+	}
+};
+
+
+template <>
+struct RollingStatTypes <true>
+{
+	typedef int64_t total_t;
+	typedef uint64_t variance_t;
+
+	// the same bit by bit method as isqrt32(), in 64 bits
+	static
+	variance_t root(variance_t v)
+	{
+		if (v <= 0xFFFFFFFFUL) return isqrt32((uint32_t) v);
+		uint64_t root = 0, place = 1ULL << 62;
+		while (place > v) place >>= 2;
+		while (place)
+		{
+			if (v >= root + place)
+			{
+				v -= root + place;
+				root += place << 1;
+			}
+			root >>= 1;
+			place >>= 2;
+		}
+		return root;
+	}
+};
+
+}
+
 
-// adapted from RunningStat, http://www.johndcook.com/standard_deviation.html
 /** @ingroup sensortools
-WARNING: this class is work in progress, don't use it yet.
-Calculates an approximation of the variance and standard deviation for a window of recent inputs.
-@tparam T the type of numbers to use.  Choose unsigned int, int , uint8_t, int8_t, or float
-@tparam WINDOW_LENGTH how many recent input values to include in the calculations.
+Calculates the mean, variance, standard deviation, minimum and maximum of a window of recent inputs,
+for example to follow the level and spread of a sensor for gesture detection in updateControl().
+The inputs are kept in a ring, with running sums of them and their squares for the mean and variance,
+and the minimum and maximum are tracked as inputs come and go, so update() takes about the same time whatever the window length.
+The window starts full of zeros.
+
+The variance is exact for the inputs in the window (divided by WINDOW_LENGTH, rather than WINDOW_LENGTH-1),
+rounded down, and getStandardDeviation() is its integer square root.
+The sums are kept in 32 bits for 8 bit types with windows up to 256, and in 64 bits otherwise.
+For 32 bit types, like int on 32 bit boards, the inputs have to be from -16777216 to 16777216 (24 bits and a sign),
+so the sum of their squares fits in 64 bits, and getVariance() returns a 64 bit number.
+
+The RAM needed is WINDOW_LENGTH * (sizeof(T) + 2) bytes for windows up to 256, and WINDOW_LENGTH * (sizeof(T) + 4) above that.
+@tparam T the type of numbers to use.  Choose unsigned int, int, uint16_t, int16_t, uint8_t, int8_t, or float.
+@tparam WINDOW_LENGTH how many recent input values to include in the calculations, a power of two.
 */
 template <class T, int WINDOW_LENGTH>
 class RollingStat
 {
+
+	typedef MozziPrivate::RollingStatTypes <(sizeof(T) > 2)> types;
+
 public:
+	/** The type of the variance, 64 bits for 32 bit T, and unsigned long otherwise. */
+	typedef typename types::variance_t variance_t;
+
 
 	/** Constructor */
-	RollingStat() : _previous_mean(0), _mean(0), _variance(0), WINDOW_LENGTH_AS_RSHIFT(trailingZerosConst(WINDOW_LENGTH))
+	RollingStat() : sum(0), sum_of_squares(0)
 	{}
 
 
-	/** Update the mean and variance given a new input value.
+	/** Update the statistics given a new input value.
 	@param x the next input value
-	@note timing for unsigned int 10us, int 22us
 	*/
 	void update(T x) {
-		_mean = rollingMean.next(x);
-		_variance = (((long)x - _previous_mean)*((long)x - _mean))>>WINDOW_LENGTH_AS_RSHIFT; // should really be div by (WINDOW_LENGTH-1), but exact values are not important for this application
-		_previous_mean = _mean;
+		T old = window.add(x);
+		sum += (typename types::total_t) x - old;
+		sum_of_squares += square(x);
+		sum_of_squares -= square(old);
 	}
 
 
-	/** Update the mean and variance given a new input value.
-	@param x the next input value
-	*/
-	void update(int8_t x) {
-		_mean = rollingMean.next(x);
-		_variance = (((int)x - _previous_mean)*((int)x - _mean))>>WINDOW_LENGTH_AS_RSHIFT; // should really be div by (WINDOW_LENGTH-1), but exact values are not important for this application
-		_previous_mean = _mean;
-	}
-
-
-	/** Return the mean of the last WINDOW_LENGTH number of inputs.
+	/** Return the mean of the last WINDOW_LENGTH number of inputs, rounded down.
 	@return  mean
 	*/
 	T getMean() const {
-		return _mean;
+		return (T) (sum >> WINDOW_LENGTH_AS_RSHIFT);
 	}
 
 
-	/** Return the approximate variance of the last WINDOW_LENGTH number of inputs.
-	@return  variance
-	@note This should really be calculated using WINDOW_LENGTH-1, but sacrificing accuracy for speed
-	we use the power of two value of WINDOW_LENGTH.
+	/** Return the variance of the last WINDOW_LENGTH number of inputs, rounded down.
+	@return  variance, which can be up to the square of half the range of T, 2^30 for 16 bit types.
 	*/
-	T getVariance() const {
-		return _variance;
+	variance_t getVariance() const {
+		// N * sum of squares - sum^2, divided by N^2, with sum^2 / N rounded up so the result is rounded down,
+		// worked out from the sum's quotient q and remainder r by N as q^2 N + 2 q r + r^2 / N, which can't overflow
+		sum_t s = (sum < 0) ? -sum : sum;
+		sum_t q = s >> WINDOW_LENGTH_AS_RSHIFT;
+		sum_t r = s & (WINDOW_LENGTH - 1);
+		sum_t square_over_n = ((q * q) << WINDOW_LENGTH_AS_RSHIFT) + 2 * q * r + ((r * r + WINDOW_LENGTH - 1) >> WINDOW_LENGTH_AS_RSHIFT);
+		return (variance_t) ((sum_of_squares - square_over_n) >> WINDOW_LENGTH_AS_RSHIFT);
 	}
 
-	/** Return the approximate standard deviation of the last WINDOW_LENGTH number of inputs.
+	/** Return the standard deviation of the last WINDOW_LENGTH number of inputs, the integer square root of the variance.
 	@return  standard deviation.
 	*/
 	T getStandardDeviation() const {
-		return isqrt16(_variance);
+		return (T) types::root(getVariance());
 	}
 
 
+	/** Return the smallest of the last WINDOW_LENGTH number of inputs.
+	@return  minimum
+	*/
+	T getMin() const {
+		return window.getMin();
+	}
+
+
+	/** Return the largest of the last WINDOW_LENGTH number of inputs.
+	@return  maximum
+	*/
+	T getMax() const {
+		return window.getMax();
+	}
+
 
 private:
-	T _previous_mean, _mean, _variance;
-	RollingAverage <T, WINDOW_LENGTH> rollingMean;
-	const uint8_t WINDOW_LENGTH_AS_RSHIFT;
+	typedef typename IntegerType<(sizeof(T) == 1 && WINDOW_LENGTH <= 256) ? 4 : 8>::unsigned_type sum_t;
+	static const uint8_t WINDOW_LENGTH_AS_RSHIFT = trailingZerosConst(WINDOW_LENGTH);
+
+	MozziPrivate::RollingWindow <T, WINDOW_LENGTH> window;
+	typename types::total_t sum;
+	sum_t sum_of_squares;
+
+	static inline sum_t square(T x) {
+		sum_t a = (x < 0) ? (sum_t) -(typename types::total_t) x : (sum_t) x;
+		return a * a;
+	}
 };
 
 // no need to show the specialisations
@@ -96,18 +256,37 @@ class RollingStat <float, WINDOW_LENGTH>
 public:
 
 	/** Constructor */
-	RollingStat() : _previous_mean(0), _mean(0), _variance(0), WINDOW_LENGTH_AS_RSHIFT(trailingZerosConst(WINDOW_LENGTH))
+	RollingStat() : mean(0), sum_of_squared_deviations(0)
 	{}
 
 
-	/** Update the mean and variance given a new input value.
+	/** Update the statistics given a new input value.
 	@param x the next input value
-	@note timing for float: 60 to 90us
+	@note This keeps the mean and the sum of squared deviations from it, updated as in Welford's method
+	for an input replacing an old one, which keeps the rounding errors much smaller than a sum of squares would.
+	They are still recalculated from the whole window every WINDOW_LENGTH updates, so the errors can't build up,
+	which makes those updates slower.
 	*/
 	void update(float x) {
-		_mean = rollingMean.next(x);
-		_variance = ((x - _previous_mean)*(x - _mean))/(WINDOW_LENGTH-1);
-		_previous_mean = _mean;
+		float old = window.add(x);
+		if (window.wrapped())
+		{
+			float sum = 0;
+			for (int i = 0; i < WINDOW_LENGTH; ++i) sum += window.get(i);
+			mean = sum / WINDOW_LENGTH;
+			sum_of_squared_deviations = 0;
+			for (int i = 0; i < WINDOW_LENGTH; ++i)
+			{
+				float deviation = window.get(i) - mean;
+				sum_of_squared_deviations += deviation * deviation;
+			}
+		}
+		else
+		{
+			float previous_mean = mean;
+			mean += (x - old) / WINDOW_LENGTH;
+			sum_of_squared_deviations += (x - old) * (x - mean + old - previous_mean);
+		}
 	}
 
 
@@ -115,34 +294,54 @@ public:
 	@return  mean
 	*/
 	float getMean() const {
-		return _mean;
+		return mean;
 	}
 
 
-	/** Return the approximate variance of the last WINDOW_LENGTH number of inputs.
+	/** Return the variance of the last WINDOW_LENGTH number of inputs.
 	@return  variance
 	*/
 	float getVariance() const {
-		return _variance;
+		float variance = sum_of_squared_deviations / WINDOW_LENGTH;
+		return (variance > 0) ? variance : 0;
 	}
 
-	/** Calculate and return the approximate standard deviation of the last WINDOW_LENGTH number of inputs.
+	/** Calculate and return the standard deviation of the last WINDOW_LENGTH number of inputs.
 	@return  standard deviation.
 	@note this is probably too slow to use!
 	*/
 	float getStandardDeviation() const {
-		return sqrt(_variance);
+		return sqrt(getVariance());
 	}
 
 
+	/** Return the smallest of the last WINDOW_LENGTH number of inputs.
+	@return  minimum
+	*/
+	float getMin() const {
+		return window.getMin();
+	}
+
+
+	/** Return the largest of the last WINDOW_LENGTH number of inputs.
+	@return  maximum
+	*/
+	float getMax() const {
+		return window.getMax();
+	}
+
 
 private:
-	float _previous_mean, _mean, _variance;
-	RollingAverage <float, WINDOW_LENGTH> rollingMean;
-	const uint8_t WINDOW_LENGTH_AS_RSHIFT;
+	MozziPrivate::RollingWindow <float, WINDOW_LENGTH> window;
+	float mean, sum_of_squared_deviations;
 };
 
 // no need to show the specialisations
 /** @endcond  */
 
+/**
+@example 05.Control_Filters/RollingStat/RollingStat.ino
+This example demonstrates the RollingStat class.
+*/
+
 #endif        //  #ifndef ROLLINGSTAT_H
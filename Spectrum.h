@@ -0,0 +1,373 @@
+/*
+ * Spectrum.h
+ *
+ * This file is part of Mozzi.
+ *
+ * Copyright 2012-2024 Tim Barrass and the Mozzi Team
+ *
+ * Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+ *
+ */
+
+#ifndef SPECTRUM_H_
+#define SPECTRUM_H_
+
+#include <Arduino.h>
+#include "mozzi_pgmspace.h"
+#include "mozzi_utils.h"
+#include "tables/cos4096_int16.h"
+
+/*
+Spectral analysis which shares the processor with the audio: samples are handed over in updateAudio()
+with write(), which only stores them, and the arithmetic is done in small pieces by update() in loop(),
+between the calls to audioHook(), so the audio never waits for it.
+
+The twiddle factors and tones come from COS4096X16_DATA, cos(2*pi*i/4096) as Q15,
+with sin(x) read as cos(x - pi/2), a quarter of the table earlier.
+*/
+
+
+namespace MozziPrivate {
+
+// an approximation to sqrt(a*a + b*b), within 3%, with no multiplies
+inline uint32_t approxMagnitude(int32_t re, int32_t im)
+{
+	uint32_t a = (re < 0) ? -re : re;
+	uint32_t b = (im < 0) ? -im : im;
+	if (a < b)
+	{
+		uint32_t t = a;
+		a = b;
+		b = t;
+	}
+	uint32_t m = a - (a >> 3) + (b >> 1);
+	return (m > a) ? m : a;
+}
+
+inline int16_t cos4096(uint16_t index)
+{
+	return FLASH_OR_RAM_READ<const int16_t>(COS4096X16_DATA + (index & 4095));
+}
+
+}
+
+
+
+/** A fixed point radix-2 FFT, for finding the spectrum of a block of NUM_POINTS samples, for example from getAudioInput().
+Samples go in one at a time with write(), in updateAudio(), and the transform is done a few butterflies at a time
+by update(), which goes in loop() after audioHook(), so it never holds up the audio.
+Once the transform is finished, the bins can be read until start() collects the next block.
+
+Each of the log2(NUM_POINTS) stages of the transform halves the signal, so nothing overflows,
+and a sine of amplitude A in the middle of a bin gives a magnitude of about A/4 there with the Hann window,
+or A/2 without.  Bin k is centred on k * sample rate / NUM_POINTS, and bins go up to NUM_POINTS/2.
+
+The RAM needed is 4 * NUM_POINTS bytes, so on AVR 64 or 128 points is about as far as it's sensible to go.
+
+@tparam NUM_POINTS the length of the blocks, a power of two from 8 to 4096.
+@tparam HANN_WINDOW whether to apply a Hann window to each block as it's written, which makes the peaks wider
+but stops a strong sound leaking into every other bin.
+*/
+template <uint16_t NUM_POINTS, bool HANN_WINDOW = true>
+class FixedFFT
+{
+
+	static_assert(NUM_POINTS >= 8 && NUM_POINTS <= 4096 && (NUM_POINTS & (NUM_POINTS - 1)) == 0, "NUM_POINTS must be a power of two from 8 to 4096");
+
+public:
+	/** Constructor.  This starts collecting the first block straight away.
+	*/
+	FixedFFT()
+	{
+		start();
+	}
+
+
+	/** Start collecting a new block of samples.  Call this when you have finished reading the bins of the last one.
+	*/
+	void start()
+	{
+		count = 0;
+		reversed = 0;
+		stage = 0;
+		k = 0;
+		state = COLLECTING;
+	}
+
+
+	/** Add the next sample to the block being collected.  This is quick enough for updateAudio().
+	Samples written while the transform is being done, or before start() is called after it, are ignored.
+	@param sample the sample, up to 16 bits.
+	*/
+	inline
+	void write(int sample)
+	{
+		if (state != COLLECTING) return;
+		int16_t x = (int16_t) sample;
+		if (HANN_WINDOW)
+		{
+			// (1 - cos(2*pi*n/N)) / 2, as Q15
+			uint16_t w = (uint16_t) (32767 - MozziPrivate::cos4096(count << (12 - LOG2_POINTS))) >> 1;
+			x = (int16_t) (((int32_t) x * w) >> 15);
+		}
+		// stored in bit reversed order, ready for the transform
+		re[reversed] = x;
+		im[reversed] = 0;
+		uint16_t mask = NUM_POINTS >> 1;
+		while (reversed & mask)
+		{
+			reversed ^= mask;
+			mask >>= 1;
+		}
+		reversed |= mask;
+		if (++count == NUM_POINTS) state = TRANSFORMING;
+	}
+
+
+	/** Do some more of the transform, if a block has been collected.  Call this in loop(), after audioHook().
+	@param num_butterflies how many butterflies to do in this call, which sets how long it takes.
+	There are NUM_POINTS/2 * log2(NUM_POINTS) of them in a transform, each with four multiplies.
+	@return true if the transform has just finished, so the bins are ready to read.
+	*/
+	bool update(uint16_t num_butterflies = 8)
+	{
+		if (state != TRANSFORMING) return false;
+		while (num_butterflies--)
+		{
+			butterfly();
+			if (++k == NUM_POINTS / 2)
+			{
+				k = 0;
+				if (++stage == LOG2_POINTS)
+				{
+					state = READY;
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+
+	/** Whether the transform of the last block is finished, so the bins can be read.
+	@return true if the bins are ready.
+	*/
+	inline
+	bool ready()
+	{
+		return state == READY;
+	}
+
+
+	/** The real part of a bin.
+	@param bin the bin, from 0 to NUM_POINTS/2.
+	@return the real part.
+	*/
+	inline
+	int real(uint16_t bin)
+	{
+		return re[bin];
+	}
+
+
+	/** The imaginary part of a bin.
+	@param bin the bin, from 0 to NUM_POINTS/2.
+	@return the imaginary part.
+	*/
+	inline
+	int imag(uint16_t bin)
+	{
+		return im[bin];
+	}
+
+
+	/** The magnitude of a bin, approximated to within 3% without a square root.
+	@param bin the bin, from 0 to NUM_POINTS/2.
+	@return the magnitude.
+	*/
+	inline
+	uint16_t magnitude(uint16_t bin)
+	{
+		return (uint16_t) MozziPrivate::approxMagnitude(re[bin], im[bin]);
+	}
+
+
+	/** The loudest bin, leaving out bin 0, which only holds the DC offset.
+	@return the bin with the largest magnitude, from 1 to NUM_POINTS/2.
+	*/
+	uint16_t peakBin()
+	{
+		uint16_t peak = 1, peak_magnitude = 0;
+		for (uint16_t bin = 1; bin <= NUM_POINTS / 2; ++bin)
+		{
+			uint16_t m = magnitude(bin);
+			if (m > peak_magnitude)
+			{
+				peak_magnitude = m;
+				peak = bin;
+			}
+		}
+		return peak;
+	}
+
+
+private:
+	static const uint8_t LOG2_POINTS = trailingZerosConst(NUM_POINTS);
+	enum {COLLECTING, TRANSFORMING, READY};
+
+	int16_t re[NUM_POINTS], im[NUM_POINTS];
+	uint16_t count, reversed, k;
+	uint8_t stage, state;
+
+
+	// butterfly k of stage, joining points h = 2^stage apart, with the twiddle exp(-i*pi*j/h)
+	inline
+	void butterfly()
+	{
+		uint16_t j = k & ((1 << stage) - 1);
+		uint16_t a = ((k >> stage) << (stage + 1)) + j;
+		uint16_t b = a + (1 << stage);
+		uint16_t index = j << (11 - stage);
+		int32_t wr = MozziPrivate::cos4096(index);
+		int32_t wi = -MozziPrivate::cos4096(index - 1024);
+		int32_t tr = (wr * re[b] - wi * im[b]) >> 15;
+		int32_t ti = (wr * im[b] + wi * re[b]) >> 15;
+		re[b] = (int16_t) ((re[a] - tr) >> 1);
+		im[b] = (int16_t) ((im[a] - ti) >> 1);
+		re[a] = (int16_t) ((re[a] + tr) >> 1);
+		im[a] = (int16_t) ((im[a] + ti) >> 1);
+	}
+};
+
+
+
+/** A bank of Goertzel filters, each measuring how strong one frequency is in a block of samples,
+which is much cheaper than a whole FFT when only a few frequencies matter, like detecting tones or a few notes.
+As with FixedFFT, samples are written in updateAudio() and the work is done by update() in loop(),
+with up to 32 samples waiting between the two.  Each sample costs two multiplies for each frequency.
+
+The magnitudes are scaled so a sine of amplitude A at one of the frequencies gives a magnitude of about A,
+to the nearest 16, as the input is reduced to 12 bits to leave room for the filters to ring up.
+Each filter responds to a band about 2 * UPDATE_RATE / BLOCK_SIZE wide around its frequency.
+
+@tparam NUM_FREQS how many frequencies to detect.
+@tparam BLOCK_SIZE how many samples to measure each time, a power of two up to 1024.  Longer blocks pick out the frequencies more sharply, but take longer.
+@tparam UPDATE_RATE the rate samples are written at, usually MOZZI_AUDIO_RATE.
+*/
+template <uint8_t NUM_FREQS, uint16_t BLOCK_SIZE, uint16_t UPDATE_RATE>
+class GoertzelBank
+{
+
+	static_assert(BLOCK_SIZE >= 8 && BLOCK_SIZE <= 1024 && (BLOCK_SIZE & (BLOCK_SIZE - 1)) == 0, "BLOCK_SIZE must be a power of two from 8 to 1024");
+
+public:
+	/** Constructor.
+	*/
+	GoertzelBank(): head(0), tail(0), count(0)
+	{
+		for (uint8_t i = 0; i < NUM_FREQS; ++i)
+		{
+			s1[i] = s2[i] = 0;
+			mag[i] = 0;
+			cosw[i] = 32767;
+			sinw[i] = 0;
+		}
+	}
+
+
+	/** Set one of the frequencies to detect.
+	@param index which of the frequencies, from 0 to NUM_FREQS-1.
+	@param freq the frequency in Hz, which is rounded to the nearest UPDATE_RATE/4096 Hz.
+	*/
+	void setFreq(uint8_t index, uint16_t freq)
+	{
+		uint16_t phase = (uint16_t) ((((uint32_t) freq << 12) + UPDATE_RATE / 2) / UPDATE_RATE);
+		cosw[index] = MozziPrivate::cos4096(phase);
+		sinw[index] = MozziPrivate::cos4096(phase - 1024);
+	}
+
+
+	/** Add the next sample.  This only stores it, so it's quick enough for updateAudio().
+	If update() has fallen more than 32 samples behind, the sample is dropped.
+	@param sample the sample, up to 16 bits.
+	*/
+	inline
+	void write(int sample)
+	{
+		if ((uint8_t) (head - tail) < BUFFER_SIZE) buffer[head++ & (BUFFER_SIZE - 1)] = (int16_t) sample;
+	}
+
+
+	/** Run the filters on the samples written since the last call.  Call this in loop(), after audioHook().
+	@return true if a block has just been finished, so there are new magnitudes to read.
+	*/
+	bool update()
+	{
+		bool finished = false;
+		while (tail != head)
+		{
+			int16_t x = buffer[tail++ & (BUFFER_SIZE - 1)] >> 4;
+			for (uint8_t i = 0; i < NUM_FREQS; ++i)
+			{
+				// s[n] = x[n] + 2*cos(w)*s[n-1] - s[n-2]
+				int32_t s0 = x + 2 * mulQ15(s1[i], cosw[i]) - s2[i];
+				s2[i] = s1[i];
+				s1[i] = s0;
+			}
+			if (++count == BLOCK_SIZE)
+			{
+				for (uint8_t i = 0; i < NUM_FREQS; ++i)
+				{
+					// the last output of the filter, s[n-1] - exp(-i*w)*s[n-2]
+					int32_t re = s1[i] - mulQ15(s2[i], cosw[i]);
+					int32_t im = mulQ15(s2[i], sinw[i]);
+					uint32_t m = (MozziPrivate::approxMagnitude(re, im) << 5) >> LOG2_BLOCK_SIZE;
+					mag[i] = (m > 65535) ? 65535 : (uint16_t) m;
+					s1[i] = s2[i] = 0;
+				}
+				count = 0;
+				finished = true;
+			}
+		}
+		return finished;
+	}
+
+
+	/** How strong one of the frequencies was in the last block.
+	@param index which of the frequencies, from 0 to NUM_FREQS-1.
+	@return the magnitude, about the amplitude of a sine at the frequency.
+	*/
+	inline
+	uint16_t magnitude(uint8_t index)
+	{
+		return mag[index];
+	}
+
+
+private:
+	static const uint8_t BUFFER_SIZE = 32;
+	static const uint8_t LOG2_BLOCK_SIZE = trailingZerosConst(BLOCK_SIZE);
+
+	int32_t s1[NUM_FREQS], s2[NUM_FREQS];
+	int16_t cosw[NUM_FREQS], sinw[NUM_FREQS];
+	uint16_t mag[NUM_FREQS];
+	int16_t buffer[BUFFER_SIZE];
+	uint8_t head, tail;
+	uint16_t count;
+
+
+	// (s * c) >> 15, with s up to 27 bits, split so that it only needs 16 x 16 bit multiplies
+	static inline int32_t mulQ15(int32_t s, int16_t c)
+	{
+		int16_t hi = (int16_t) (s >> 16);
+		uint16_t lo = (uint16_t) s;
+		return (int32_t) c * hi * 2 + (((int32_t) c * lo) >> 15);
+	}
+};
+
+/**
+@example 04.Audio_Input/Audio_Input_Spectrum/Audio_Input_Spectrum.ino
+This example demonstrates the FixedFFT and GoertzelBank classes.
+*/
+
+#endif        //  #ifndef SPECTRUM_H_
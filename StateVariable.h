@@ -49,6 +49,9 @@ Soc., Vol 45, No. 9, 1997 September
 #include "mozzi_fixmath.h"
 #include "mozzi_utils.h"
 #include "ResonantFilter.h"
+#include "mozzi_pgmspace.h"
+#include "tables/sqrt256_uint8.h"
+#include "tables/svftuning256_uint16.h"
 
 //enum filter_types { LOWPASS, BANDPASS, HIGHPASS, NOTCH };
 
@@ -67,7 +70,7 @@ template <int8_t FILTER_TYPE> class StateVariable {
 public:
   /** Constructor.
    */
-  StateVariable() {}
+  StateVariable() : hz_tuned(false) {}
 
   /** Set how resonant the filter will be.
   @param resonance a byte value between 1 and 255.
@@ -80,7 +83,8 @@ public:
     // qvalue goes from 255 to 0, representing .999 to 0 in fixed point
     // lower q, more resonance
     q = resonance;
-    scale = (Q0n8)sqrt((unsigned int)resonance << 8);
+    scale = FLASH_OR_RAM_READ<const uint8_t>(SQRT256_DATA + resonance); // sqrt(q), from a table
+    if (hz_tuned) tune();
   }
 
   /** Set the centre or corner frequency of the filter.
@@ -89,9 +93,10 @@ public:
   centre frequency to pass or reduce for BANDPASS and NOTCH.
   @note Timing 25-30us
   @note The frequency calculation is VERY "approximate".  This really needs to
-  be fixed.
+  be fixed.  setCentreFreqHz() is accurate and faster.
   */
   void setCentreFreq(unsigned int centre_freq) {
+    hz_tuned = false;
     // simple frequency tuning with error towards nyquist (reference?  where did
     // this come from?)
     // f = (Q1n15)(((Q16n16_2PI*centre_freq)>>AUDIO_RATE_AS_LSHIFT)>>1);
@@ -104,6 +109,21 @@ public:
     // float_to_Q15n16(2.0f *sin(ff));
   }
 
+  /** Set the centre or corner frequency of the filter, accurately tuned in Hz.
+  This uses the exact f = 2*sin(pi*centre_freq/MOZZI_AUDIO_RATE), from a table
+  (see Q1n15_filterCoeffFromHz()), corrected for the resonance setting which
+  otherwise pulls the frequency down.  It costs a few table reads and
+  multiplies, so it's quick enough for filter envelopes at every control update.
+  The frequency stays in tune when setResonance() is called afterwards.
+  @param centre_freq 20 - MOZZI_AUDIO_RATE/4 Hz.  Resonant settings (low
+  resonance values) become unstable at lower frequencies than this.
+  */
+  void setCentreFreqHz(uint16_t centre_freq) {
+    hz_coeff = Q1n15_filterCoeffFromHz(centre_freq);
+    hz_tuned = true;
+    tune();
+  }
+
   /** Calculate the next sample, given an input signal.
   @param input the signal input.
   @return the signal output.
@@ -120,6 +140,13 @@ private:
   int low, band;
   Q0n8 q, scale;
   volatile Q15n16 f;
+  uint16_t hz_coeff; // Q1n15, from setCentreFreqHz()
+  bool hz_tuned;
+
+  // set f from hz_coeff, divided by sqrt(scale) because next() scales the feedback by scale
+  inline void tune() {
+    f = ((uint32_t)hz_coeff * FLASH_OR_RAM_READ<const uint16_t>(SVFTUNING256_DATA + scale)) >> 13;
+  }
 
   /** Calculate the next sample, given an input signal.
   @param in the signal input.
@@ -182,9 +209,113 @@ private:
   }
 };
 
+
+/** A State Variable filter which runs its loop several times per sample and
+can saturate its resonance, so it stays in tune and stable up to nearly half
+the audio rate, and a loud resonant peak is held at a steady level instead of
+wrapping around.
+Unlike StateVariable, only the input is scaled by the resonance setting, as in
+Chamberlin's original, so the centre frequency doesn't depend on resonance.
+Its setCentreFreqHz() is exact, from the same table as StateVariable's.
+@tparam FILTER_TYPE choose between LOWPASS, BANDPASS, HIGHPASS and NOTCH.
+@tparam OVERSAMPLING how many times the filter loop runs per sample: 2 (the
+default) reaches nearly MOZZI_AUDIO_RATE/2, 1 saves the extra time and is
+limited to about MOZZI_AUDIO_RATE/5, like StateVariable.  4 is also allowed.
+@tparam SATURATE true (the default) soft clips the band signal inside the loop,
+at about 16384, and hard clips the low signal.  false saves the time, for
+example in 16 kHz AVR sketches, but loud or very resonant signals will wrap
+around instead of saturating.
+*/
+template <int8_t FILTER_TYPE, uint8_t OVERSAMPLING = 2, bool SATURATE = true>
+class StateVariableOversampled {
+
+  static_assert(OVERSAMPLING == 1 || OVERSAMPLING == 2 || OVERSAMPLING == 4, "OVERSAMPLING must be 1, 2 or 4");
+
+public:
+  /** Constructor.
+   */
+  StateVariableOversampled() : low(0), band(0), q(255), scale(255), f(0), f_target(0) {}
+
+  /** Set how resonant the filter will be.
+  @param resonance a byte value between 1 and 255.
+  The lower this value is, the more resonant the filter.  With SATURATE, even
+  the most resonant settings driven hard stay at a level held by the soft
+  clipping.
+  */
+  void setResonance(Q0n8 resonance) {
+    q = resonance;
+    scale = FLASH_OR_RAM_READ<const uint8_t>(SQRT256_DATA + resonance);
+    limit();
+  }
+
+  /** Set the centre or corner frequency of the filter, in Hz.
+  @param centre_freq 20 Hz up to nearly MOZZI_AUDIO_RATE/2 with 2x
+  OVERSAMPLING, or MOZZI_AUDIO_RATE/4 without.  At low resonance the top of
+  the range is lower, as the filter loop would become unstable.
+  */
+  void setCentreFreqHz(uint16_t centre_freq) {
+    // the coefficient is worked out for the oversampled rate
+    f_target = Q1n15_filterCoeffFromHz(centre_freq / OVERSAMPLING);
+    limit();
+  }
+
+  /** Calculate the next sample, given an input signal.
+  @param input the signal input, up to 15 bits.
+  @return the signal output, averaged over the oversampled steps.
+  */
+  inline int next(int input) {
+    long in = ((long)input * scale) >> 8;
+    long out = 0;
+    for (uint8_t i = 0; i < OVERSAMPLING; ++i) {
+      low = clip(low + (((long)band * f + 16384) >> 15), Int2Type<SATURATE>());
+      int high = clip(in - low - (((long)band * q) >> 8), Int2Type<SATURATE>());
+      band = saturateBand(band + (((long)high * f + 16384) >> 15), Int2Type<SATURATE>());
+      out += output(high, Int2Type<FILTER_TYPE>());
+    }
+    return (int)(out >> trailingZerosConst(OVERSAMPLING));
+  }
+
+private:
+  static const long CLIP_LEVEL = 1L << 14;
+  int low, band;
+  Q0n8 q, scale;
+  uint16_t f, f_target; // Q1n15
+
+  // the loop is only stable up to about f = 2 - q
+  inline void limit() {
+    uint16_t f_max = 63488 - ((uint16_t)q << 7);
+    f = (f_target < f_max) ? f_target : f_max;
+  }
+
+  inline long output(int high, Int2Type<LOWPASS>) { return low; }
+  inline long output(int high, Int2Type<BANDPASS>) { return band; }
+  inline long output(int high, Int2Type<HIGHPASS>) { return high; }
+  inline long output(int high, Int2Type<NOTCH>) { return (long)high + low; }
+
+  inline int clip(long x, Int2Type<false>) { return (int)x; }
+  inline int clip(long x, Int2Type<true>) {
+    return (int)constrain(x, -32767L, 32767L);
+  }
+
+  inline int saturateBand(long x, Int2Type<false>) { return (int)x; }
+  // cubic soft clip, x - x^3/(6.75*CLIP_LEVEL^2), which levels off at
+  // CLIP_LEVEL when x reaches 1.5*CLIP_LEVEL
+  inline int saturateBand(long x, Int2Type<true>) {
+    if (x >= (3 * CLIP_LEVEL) / 2) return CLIP_LEVEL;
+    if (x <= -(3 * CLIP_LEVEL) / 2) return -CLIP_LEVEL;
+    long x2 = (x * x) >> 14;
+    long x3 = (x2 * x) >> 14;
+    return (int)(x - ((x3 * 9709) >> 16)); // 9709/65536 is 1/6.75
+  }
+};
+
+
 /**
 @example 11.Audio_Filters/StateVariableFilter/StateVariableFilter.ino
 This example demonstrates the StateVariable class.
+
+@example 10.Audio_Filters/StateVariableOversampled/StateVariableOversampled.ino
+This example demonstrates the StateVariableOversampled class.
 */
 
 #endif /* STATEVARIABLE_H_ */
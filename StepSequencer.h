@@ -0,0 +1,209 @@
+/*
+ * StepSequencer.h
+ *
+ * This file is part of Mozzi.
+ *
+ * Copyright 2012-2024 Tim Barrass and the Mozzi Team
+ *
+ * Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+ *
+ */
+
+#ifndef STEPSEQUENCER_H_
+#define STEPSEQUENCER_H_
+
+#include <Arduino.h>
+#include "mozzi_pgmspace.h"
+
+
+/** A step of a StepSequencer pattern which plays a note, packed into 16 bits:
+the top bit is set for a note, then 7 bits of note number and 8 of velocity.
+@param note the note number, usually a midi note, from 0 to 127.
+@param velocity how loud, from 1 to 255.
+@return the step, for a pattern in CONSTTABLE_STORAGE(uint16_t).
+*/
+constexpr uint16_t sequencerNote(uint8_t note, uint8_t velocity)
+{
+	return 0x8000 | ((uint16_t) (note & 127) << 8) | velocity;
+}
+
+/** A step of a StepSequencer pattern which plays nothing. */
+#define SEQUENCER_REST 0
+
+
+/** Plays patterns of notes on several tracks, stepping in time with the audio ticks, and calls a function for each note.
+Each track's pattern is an array of steps made with sequencerNote() or SEQUENCER_REST, 2 bytes each, in
+CONSTTABLE_STORAGE(uint16_t) so it stays in flash, as Oscil's tables do.  The tracks can have patterns of different lengths, for polymeters,
+and all step at the same rate, set with setBPM().
+
+The sequencer counts audio ticks itself, adding MOZZI_AUDIO_RATE / MOZZI_CONTROL_RATE each update(), which is
+how many samples updateAudio() makes between updateControl()s, so its clock follows the audio as it is made,
+without the jitter of audioTicks(), which counts samples as they leave the output buffer.
+The time of every step is kept in those ticks, with fractions so the tempo doesn't drift, and update() only compares
+the clock with the time of the next step of any track, so it costs the same whatever the number of tracks
+until a step is due.  Each update() plays the steps which start before the next one, and gives each note the number
+of audio ticks until its step actually starts, so a sketch which counts those down in updateAudio() can start notes
+exactly on the step, rather than at the control step before it.
+
+@tparam NUM_TRACKS how many tracks there are.
+*/
+template <uint8_t NUM_TRACKS>
+class StepSequencer
+{
+
+public:
+	/** The type of the function called for each note, with the track it's on, its note number and velocity,
+	and how many samples after the update() which called it the step starts, from 0 for the next updateAudio().
+	*/
+	typedef void (*callback_t)(uint8_t track, uint8_t note, uint8_t velocity, uint16_t delay_ticks);
+
+
+	/** Constructor.
+	@param callback the function called for each note.
+	@param bpm the starting tempo.
+	@param steps_per_beat how many steps there are in a beat, 4 for sixteenth notes.
+	*/
+	StepSequencer(callback_t callback, unsigned int bpm = 120, uint8_t steps_per_beat = 4):
+		callback(callback), running(false), clock(0)
+	{
+		for (uint8_t t = 0; t < NUM_TRACKS; ++t)
+		{
+			patterns[t] = 0;
+			lengths[t] = 0;
+			positions[t] = 0;
+		}
+		setBPM(bpm, steps_per_beat);
+	}
+
+
+	/** Set the pattern a track plays, from the start of the pattern.
+	@param track which track, from 0 to NUM_TRACKS-1.
+	@param pattern the steps, made with sequencerNote() or SEQUENCER_REST, in CONSTTABLE_STORAGE(uint16_t).
+	On AVR they are always read from flash, so a pattern in RAM would play garbage there.
+	@param num_steps how many steps the pattern has.  0 silences the track.
+	*/
+	inline
+	void setPattern(uint8_t track, const uint16_t * pattern, uint8_t num_steps)
+	{
+		patterns[track] = pattern;
+		lengths[track] = num_steps;
+		positions[track] = 0;
+	}
+
+
+	/** Set the tempo, from the next step.
+	@param bpm beats per minute.
+	@param steps_per_beat how many steps there are in a beat, 4 for sixteenth notes.
+	@note This divides, so it is better not to call it every control step.
+	*/
+	void setBPM(unsigned int bpm, uint8_t steps_per_beat = 4)
+	{
+		// audio ticks per step, with 8 fractional bits
+		unsigned long step = ((unsigned long) MOZZI_AUDIO_RATE * 60 * 256) / ((unsigned long) bpm * steps_per_beat);
+		step_ticks = step >> 8;
+		step_fraction = (uint8_t) step;
+	}
+
+
+	/** Start playing, with every track at the start of its pattern, on the next update().
+	*/
+	void start()
+	{
+		for (uint8_t t = 0; t < NUM_TRACKS; ++t)
+		{
+			positions[t] = 0;
+			due[t] = clock;
+			fraction[t] = 0;
+		}
+		next_due = clock;
+		running = true;
+	}
+
+
+	/** Stop playing.  start() begins again from the starts of the patterns.
+	*/
+	inline
+	void stop()
+	{
+		running = false;
+	}
+
+
+	/** Tells if the sequencer is playing.
+	@return true if it's playing.
+	*/
+	inline
+	bool playing() const
+	{
+		return running;
+	}
+
+
+	/** The step a track is on.
+	@param track which track, from 0 to NUM_TRACKS-1.
+	@return the index of the next step to play, in its pattern.
+	*/
+	inline
+	uint8_t position(uint8_t track) const
+	{
+		return positions[track];
+	}
+
+
+	/** Play the steps which start before the next update().  Call this once in updateControl(), every control step.
+	*/
+	void update()
+	{
+		if (!running) return;
+		unsigned long now = clock;
+		clock += TICKS_PER_UPDATE;
+		if ((long) (next_due - clock) >= 0) return;
+
+		next_due = now + 0x7fffffffUL; // further than any step can be
+		for (uint8_t t = 0; t < NUM_TRACKS; ++t)
+		{
+			while ((long) (due[t] - clock) < 0)
+			{
+				if (lengths[t])
+				{
+					uint16_t step = FLASH_OR_RAM_READ<const uint16_t>(patterns[t] + positions[t]);
+					if (++positions[t] >= lengths[t]) positions[t] = 0;
+					if (step & 0x8000)
+					{
+						long delay_ticks = (long) (due[t] - now);
+						callback(t, (step >> 8) & 127, (uint8_t) step, (delay_ticks > 0) ? (uint16_t) delay_ticks : 0);
+					}
+				}
+				uint16_t f = (uint16_t) fraction[t] + step_fraction;
+				fraction[t] = (uint8_t) f;
+				due[t] += step_ticks + (f >> 8);
+			}
+			if ((long) (due[t] - next_due) < 0) next_due = due[t];
+		}
+	}
+
+
+private:
+	static const unsigned int TICKS_PER_UPDATE = MOZZI_AUDIO_RATE / MOZZI_CONTROL_RATE;
+
+	callback_t callback;
+	bool running;
+	unsigned long clock; // audio ticks made since the sequencer was constructed
+	unsigned long next_due; // the earliest step of any track
+	unsigned long step_ticks;
+	uint8_t step_fraction;
+
+	// the state of each track
+	const uint16_t * patterns[NUM_TRACKS];
+	uint8_t lengths[NUM_TRACKS];
+	uint8_t positions[NUM_TRACKS];
+	unsigned long due[NUM_TRACKS]; // when the next step starts, in audio ticks
+	uint8_t fraction[NUM_TRACKS]; // and the fraction of a tick
+};
+
+/**
+@example 02.Control/StepSequencer/StepSequencer.ino
+This example shows how to use the StepSequencer class.
+*/
+
+#endif /* STEPSEQUENCER_H_ */
@@ -0,0 +1,93 @@
+/*
+ * SubRate.h
+ *
+ * This file is part of Mozzi.
+ *
+ * Copyright 2012-2024 Tim Barrass and the Mozzi Team
+ *
+ * Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+ *
+ */
+
+#ifndef SUBRATE_H_
+#define SUBRATE_H_
+
+#include <Arduino.h>
+#include "mozzi_utils.h"
+#include "internal/subrate_p.h"
+
+
+/** Runs part of a patch at a fraction of the audio rate, and interpolates it back up to MOZZI_AUDIO_RATE.
+Sounds which don't need the whole audio rate, like a sub-bass, a slow drone or a reverb tail,
+can go in an update function of their own, which Mozzi then calls only every DIVIDER audio frames.
+Its Oscils and other audio rate objects should be made for MOZZI_AUDIO_RATE/DIVIDER, for example
+Oscil <SIN2048_NUM_CELLS, MOZZI_AUDIO_RATE/4> aSub(SIN2048_DATA); for a SubRate<4>.
+
+Mozzi staggers the update functions, so for example two SubRate<2>s run on alternate frames, and four SubRate<4>s
+each get a frame of their own, which keeps the time taken by each frame even rather than making every few frames slow.
+The update function's samples are joined up with straight lines, which is fine for low sounds and smooth ones,
+but leaves a little of the stepped sound at higher frequencies.  HalfBandInterpolator gives a cleaner result for brighter sounds.
+
+@tparam DIVIDER how many audio frames each sample of the update function lasts: 2, 4 or 8.
+
+Usage:
+@code
+int updateSubBass() {
+  return aSub.next() << 6;
+}
+
+SubRate <4> subBass(updateSubBass); // at file scope, like the Oscils
+
+AudioOutput updateAudio() {
+  return MonoOutput::fromNBit(14, aLead.next() * 32 + subBass.next());
+}
+@endcode
+*/
+template <uint8_t DIVIDER>
+class SubRate: private MozziPrivate::SubRateNode
+{
+
+	static_assert(DIVIDER == 2 || DIVIDER == 4 || DIVIDER == 8, "SubRate's DIVIDER must be 2, 4 or 8");
+
+public:
+	/** Constructor.  This adds the update function to the ones Mozzi calls.
+	@param update_function the function to call every DIVIDER audio frames.  It takes nothing, and returns a sample up to 16 bits.
+	*/
+	SubRate(int (*update_function)())
+	{
+		update = update_function;
+		value = step = 0;
+		target = 0;
+		mask = DIVIDER - 1;
+		shift = trailingZerosConst(DIVIDER);
+		MozziPrivate::SubRatePrivate::add(this);
+	}
+
+
+	/** Destructor.  This stops Mozzi calling the update function.
+	*/
+	~SubRate()
+	{
+		MozziPrivate::SubRatePrivate::remove(this);
+	}
+
+
+	/** The output of the update function, interpolated to the current audio frame.
+	Call this once in every updateAudio(), as each call moves the interpolation on by a frame.
+	The output is a few frames later than the update function's samples, DIVIDER frames at most.
+	@return the interpolated output.
+	*/
+	inline
+	int next()
+	{
+		value += step;
+		return (int) (value >> 8);
+	}
+};
+
+/**
+@example 12.Misc/SubRate/SubRate.ino
+This example demonstrates the SubRate class.
+*/
+
+#endif        //  #ifndef SUBRATE_H_
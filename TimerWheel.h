@@ -0,0 +1,291 @@
+/*
+ * TimerWheel.h
+ *
+ * This file is part of Mozzi.
+ *
+ * Copyright 2012-2024 Tim Barrass and the Mozzi Team
+ *
+ * Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+ *
+ */
+
+#ifndef TIMERWHEEL_H_
+#define TIMERWHEEL_H_
+
+#include <Arduino.h>
+
+
+/** Many one-shot and repeating timers, counted in audio ticks, checked together with one update() in updateControl().
+Where each EventDelay or Metronome has to be polled with ready(), which reads audioTicks() each time,
+a TimerWheel keeps its timers in a ring of slots, each slot holding the timers which are due in its stretch of audio ticks,
+so update() only looks at the one or two slots which the audio ticks have reached since it was last called,
+however many timers there are.  Starting and cancelling a timer take the same time whatever else is running,
+as each slot is a linked list of timers.  A timer due more than a turn of the wheel away waits in its slot for the later turns.
+
+When a timer is due, update() calls its callback, if it has one, or else ready() returns true for it, once.
+A timer fires in the first update() at or after its time, so, like EventDelay, its timing is as fine as the control rate.
+Repeating timers are rescheduled from when they were due, rather than when they fired, so they don't drift,
+and can have swing, which delays every second beat by part of the period.
+
+@tparam NUM_TIMERS how many timers there are, up to 254.  Each takes about 20 bytes of RAM.
+@tparam NUM_SLOTS how many slots are in the wheel, a power of two.  More slots mean fewer timers to look at in each one.
+@tparam SLOT_SHIFT each slot covers 2^SLOT_SHIFT audio ticks.  This shouldn't be longer than a control step,
+MOZZI_AUDIO_RATE / MOZZI_CONTROL_RATE ticks, so the default of 256 ticks suits the standard control rate of 64 and higher
+rates up to 128 at 32768 Hz.
+*/
+template <uint8_t NUM_TIMERS, uint8_t NUM_SLOTS = 32, uint8_t SLOT_SHIFT = 8>
+class TimerWheel
+{
+
+	static_assert(NUM_TIMERS >= 1 && NUM_TIMERS < 255, "NUM_TIMERS must be from 1 to 254");
+	static_assert(NUM_SLOTS >= 2 && (NUM_SLOTS & (NUM_SLOTS - 1)) == 0, "NUM_SLOTS must be a power of two");
+
+public:
+	/** The type of callback functions, which are given the number of the timer which fired. */
+	typedef void (*callback_t)(uint8_t timer);
+
+
+	/** Constructor.  All the timers start stopped, with no callbacks and no swing.
+	*/
+	TimerWheel(): wheel_slot(0)
+	{
+		for (uint8_t s = 0; s < NUM_SLOTS; ++s) heads[s] = NONE;
+		for (uint8_t t = 0; t < NUM_TIMERS; ++t)
+		{
+			flags[t] = 0;
+			swing[t] = 0;
+			callbacks[t] = 0;
+			base[t] = period[t] = when[t] = 0;
+		}
+	}
+
+
+	/** Set the function to call when a timer fires.
+	@param timer which timer, from 0 to NUM_TIMERS-1.
+	@param callback the function, or 0 to use ready() instead.
+	*/
+	inline
+	void setCallback(uint8_t timer, callback_t callback)
+	{
+		callbacks[timer] = callback;
+	}
+
+
+	/** Start a timer, or restart it if it's already running.
+	@param timer which timer, from 0 to NUM_TIMERS-1.
+	@param delay_milliseconds how long until it fires, and the time between beats if it's repeating.
+	@param repeat whether it keeps firing every delay_milliseconds, like a Metronome, until it's cancelled.
+	*/
+	inline
+	void start(uint8_t timer, unsigned int delay_milliseconds, bool repeat = false)
+	{
+		startTicks(timer, msToTicks(delay_milliseconds), repeat);
+	}
+
+
+	/** Start a timer, or restart it if it's already running, with the delay in audio ticks.
+	@param timer which timer, from 0 to NUM_TIMERS-1.
+	@param delay_ticks how many audio ticks until it fires, and the time between beats if it's repeating.
+	@param repeat whether it keeps firing every delay_ticks until it's cancelled.
+	*/
+	void startTicks(uint8_t timer, unsigned long delay_ticks, bool repeat = false)
+	{
+		if (flags[timer] & ACTIVE) unlink(timer);
+		base[timer] = audioTicks() + delay_ticks;
+		period[timer] = delay_ticks;
+		flags[timer] = repeat ? (ACTIVE | REPEATING) : ACTIVE;
+		schedule(timer);
+		link(timer);
+	}
+
+
+	/** Change the time between the beats of a repeating timer, from the beat after the next one,
+	so it stays in step while the tempo changes.
+	@param timer which timer, from 0 to NUM_TIMERS-1.
+	@param period_milliseconds the time between beats.
+	*/
+	inline
+	void setPeriod(uint8_t timer, unsigned int period_milliseconds)
+	{
+		period[timer] = msToTicks(period_milliseconds);
+	}
+
+
+	/** Set the swing of a repeating timer, which delays every second beat, from the next one to be scheduled.
+	@param timer which timer, from 0 to NUM_TIMERS-1.
+	@param amount how far to delay the off-beats, as a fraction of the period, from 0 for straight time to 255.
+	85 gives the triplet feel of a beat pair in the ratio 2:1.
+	*/
+	inline
+	void setSwing(uint8_t timer, uint8_t amount)
+	{
+		swing[timer] = amount;
+	}
+
+
+	/** Stop a timer, so it doesn't fire, and forget it if it has fired without being read with ready().
+	@param timer which timer, from 0 to NUM_TIMERS-1.
+	*/
+	void cancel(uint8_t timer)
+	{
+		if (flags[timer] & ACTIVE) unlink(timer);
+		flags[timer] = 0;
+	}
+
+
+	/** Tells if a timer is running.
+	@param timer which timer, from 0 to NUM_TIMERS-1.
+	@return true if it's waiting to fire, or is repeating.
+	*/
+	inline
+	bool active(uint8_t timer) const
+	{
+		return flags[timer] & ACTIVE;
+	}
+
+
+	/** For a timer without a callback, tells if it has fired since the last time this was called.
+	@param timer which timer, from 0 to NUM_TIMERS-1.
+	@return true once for each time it fired.
+	*/
+	inline
+	bool ready(uint8_t timer)
+	{
+		if (!(flags[timer] & READY)) return false;
+		flags[timer] &= ~READY;
+		return true;
+	}
+
+
+	/** Fire the timers which are due.  Call this once in updateControl().
+	Each timer fires at most once in each update(), so a repeating timer which is faster than the control rate,
+	or which has fallen behind, catches up over the following updates.
+	*/
+	void update()
+	{
+		unsigned long now = audioTicks();
+		unsigned long now_slot = now >> SLOT_SHIFT;
+		// if it's been more than a turn since the last update, each slot only needs looking at once
+		if ((long) (now_slot - wheel_slot) >= NUM_SLOTS) wheel_slot = now_slot - (NUM_SLOTS - 1);
+
+		uint8_t num_due = 0;
+		while (true)
+		{
+			uint8_t t = heads[wheel_slot & SLOT_MASK];
+			while (t != NONE)
+			{
+				uint8_t following = next_timer[t];
+				if (!(flags[t] & FIRED) && (long) (now - when[t]) >= 0)
+				{
+					unlink(t);
+					due[num_due++] = t;
+					if (flags[t] & REPEATING)
+					{
+						base[t] += period[t];
+						flags[t] ^= OFF_BEAT;
+						schedule(t);
+					}
+					else
+					{
+						flags[t] &= ~ACTIVE;
+					}
+					flags[t] |= FIRED;
+				}
+				t = following;
+			}
+			// the slot the ticks are in now is looked at again next time, as some of its timers may be due later in it
+			if (wheel_slot == now_slot) break;
+			++wheel_slot;
+		}
+
+		// repeating timers go back in once the scan has reached now's slot, so any which are already due again
+		// go in that slot, rather than one the scan has passed, which wouldn't be looked at for a whole turn
+		for (uint8_t i = 0; i < num_due; ++i)
+		{
+			if (flags[due[i]] & ACTIVE) link(due[i]);
+		}
+
+		// the callbacks are called once the wheel is tidy, so they can start and cancel timers
+		for (uint8_t i = 0; i < num_due; ++i)
+		{
+			uint8_t t = due[i];
+			if (!(flags[t] & FIRED)) continue; // cancelled by an earlier callback
+			flags[t] &= ~FIRED;
+			if (callbacks[t]) callbacks[t](t);
+			else flags[t] |= READY;
+		}
+	}
+
+
+private:
+	enum {ACTIVE = 1, REPEATING = 2, OFF_BEAT = 4, READY = 8, FIRED = 16};
+	static const uint8_t NONE = 255;
+	static const uint8_t SLOT_MASK = NUM_SLOTS - 1;
+	static const unsigned int TICKS_PER_MILLISECOND = MOZZI_AUDIO_RATE / 1000;
+	static const unsigned int TICKS_PER_MILLISECOND_FRACTION = ((MOZZI_AUDIO_RATE % 1000) * 65536UL + 500) / 1000; // Q0n16
+
+	// the state of each timer
+	unsigned long base[NUM_TIMERS]; // when it's next due, before swing
+	unsigned long when[NUM_TIMERS]; // when it's next due, with the swing it had when it was scheduled
+	unsigned long period[NUM_TIMERS];
+	callback_t callbacks[NUM_TIMERS];
+	uint8_t swing[NUM_TIMERS];
+	uint8_t flags[NUM_TIMERS];
+	uint8_t slot[NUM_TIMERS];
+	uint8_t next_timer[NUM_TIMERS], prev_timer[NUM_TIMERS];
+
+	// the first timer in each slot, the next slot to look at, counted from the start, and the timers firing in an update()
+	uint8_t heads[NUM_SLOTS];
+	unsigned long wheel_slot;
+	uint8_t due[NUM_TIMERS];
+
+
+	static inline
+	unsigned long msToTicks(unsigned int msec)
+	{
+		return (unsigned long) msec * TICKS_PER_MILLISECOND + (((unsigned long) msec * TICKS_PER_MILLISECOND_FRACTION) >> 16);
+	}
+
+
+	// work out when a timer is next due, with every second beat delayed by its swing, and keep it,
+	// so changing the swing or period doesn't move a beat out of the slot it's in
+	inline
+	void schedule(uint8_t t)
+	{
+		when[t] = base[t];
+		if (flags[t] & OFF_BEAT)
+		{
+			unsigned long p = period[t];
+			when[t] += (p >> 8) * swing[t] + (((p & 255) * swing[t]) >> 8);
+		}
+	}
+
+
+	// put a timer at the front of its slot's list, or in the current slot if its time has gone
+	void link(uint8_t t)
+	{
+		unsigned long s = when[t] >> SLOT_SHIFT;
+		if ((long) (s - wheel_slot) < 0) s = wheel_slot;
+		uint8_t head = (uint8_t) s & SLOT_MASK;
+		slot[t] = head;
+		prev_timer[t] = NONE;
+		next_timer[t] = heads[head];
+		if (heads[head] != NONE) prev_timer[heads[head]] = t;
+		heads[head] = t;
+	}
+
+
+	void unlink(uint8_t t)
+	{
+		if (prev_timer[t] != NONE) next_timer[prev_timer[t]] = next_timer[t];
+		else heads[slot[t]] = next_timer[t];
+		if (next_timer[t] != NONE) prev_timer[next_timer[t]] = prev_timer[t];
+	}
+};
+
+/**
+@example 02.Control/TimerWheel/TimerWheel.ino
+This example shows how to use the TimerWheel class.
+*/
+
+#endif /* TIMERWHEEL_H_ */
@@ -39,7 +39,7 @@ public:
 
 	/** Constructor.
 	*/
-	WavePacket():AUDIO_STEPS_PER_CONTROL(MOZZI_AUDIO_RATE / MOZZI_CONTROL_RATE)
+	WavePacket()
 	{
 		aCos.setTable(COS8192_DATA);
 	}
@@ -87,7 +87,7 @@ public:
 		Q15n16 bw = invFreq*bandwidth;
 		bw >>= 9;
 		bw = max(bw, Q15n16_FIX1>>3);
-		aBandwidth.set(bw, AUDIO_STEPS_PER_CONTROL);
+		aBandwidth.setTarget<AUDIO_STEPS_PER_CONTROL>(bw);
 	}
 
 
@@ -101,7 +101,7 @@ public:
 	{
 		Q15n16 cf = invFreq * centrefreq;
 		cf >>= 3;
-		aCentrefreq.set(cf, AUDIO_STEPS_PER_CONTROL);
+		aCentrefreq.setTarget<AUDIO_STEPS_PER_CONTROL>(cf);
 	}
 
 
@@ -145,7 +145,7 @@ private:
 	params1,params2;
 
 	// the number of audio steps the line has to take to reach the next control value
-	const unsigned int AUDIO_STEPS_PER_CONTROL;
+	static const unsigned int AUDIO_STEPS_PER_CONTROL = MOZZI_AUDIO_RATE / MOZZI_CONTROL_RATE;
 
 	Oscil <COS8192_NUM_CELLS, MOZZI_AUDIO_RATE> aCos;
 	Phasor <MOZZI_AUDIO_RATE> aPhasor;
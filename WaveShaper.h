@@ -13,6 +13,9 @@
 #define WAVESHAPER_H_
 
 #include "Arduino.h"
+#include "mozzi_pgmspace.h"
+#include "mozzi_utils.h"
+#include <math.h>
 
 /** WaveShaper maps values from its input to values in a table, which are returned as output.
 @tparam T the type of numbers being input to be shaped, chosen to match the table.
@@ -97,7 +100,147 @@ private:
 	const int16_t * table;
 };
 
+
+
+/** A WaveShaper for 16 bit signals, which interpolates between the cells of its table, so a small table
+gives smooth, hi-fi shaping without the steps a raw table lookup makes.
+The table is kept in RAM, and can be filled in setup() with a tanh, foldback or Chebyshev curve,
+or copied from a table in flash with setTable().
+
+The whole range of a 16 bit input, -32768 to 32767, maps onto the table, so there's no offset to add,
+and larger values (on boards where int is 32 bits) are limited to that range instead of reading past the end of the table.
+With the default 257 cells, the high byte of the input chooses the cell and the low byte interpolates to the next one.
+
+@tparam NUM_CELLS the length of the table, a power of two plus one: 65 (130 bytes of RAM) suits AVR, 257 (514 bytes) is the default.
+*/
+template <uint16_t NUM_CELLS = 257>
+class InterpolatingWaveShaper
+{
+
+	static_assert(NUM_CELLS >= 3 && ((NUM_CELLS - 1) & (NUM_CELLS - 2)) == 0, "NUM_CELLS must be a power of two plus one");
+
+public:
+	/** Constructor.  The table starts as a straight line, which leaves the signal unchanged.
+	*/
+	InterpolatingWaveShaper()
+	{
+		for (uint16_t i = 0; i < NUM_CELLS; ++i) table[i] = (int16_t) constrain(((int32_t) i << (16 - INDEX_BITS)) - 32768L, -32767L, 32767L);
+	}
+
+
+	/** Fill the table with a tanh curve, for a soft, valve-like saturation.  This uses floats, so call it in setup() or rarely.
+	@param drive how hard the curve squashes, for example 1 for gentle, 4 for heavy.
+	The curve is scaled so a full scale input still gives a full scale output.
+	*/
+	void setTanh(float drive)
+	{
+		const float norm = 32767.f / tanhf(drive);
+		for (uint16_t i = 0; i < NUM_CELLS; ++i) table[i] = (int16_t) (tanhf(drive * x(i)) * norm);
+	}
+
+
+	/** Fill the table with a foldback curve, which reflects the signal back each time it reaches full scale,
+	adding bright, harmonically rich overtones as the gain goes up.  This uses floats, so call it in setup() or rarely.
+	@param gain how much the signal is amplified before folding, 1 for no folding, 2 or more to fold.
+	*/
+	void setFoldback(float gain)
+	{
+		for (uint16_t i = 0; i < NUM_CELLS; ++i)
+		{
+			// a triangle wave of the amplified signal, with period 4
+			float y = fmodf(gain * x(i) + 1.f, 4.f);
+			if (y < 0) y += 4.f;
+			y = (y < 2.f) ? y - 1.f : 3.f - y;
+			table[i] = (int16_t) (y * 32767.f);
+		}
+	}
+
+
+	/** Fill the table with a mix of Chebyshev polynomials.  Shaping a full scale sine with the Chebyshev polynomial T_n
+	gives its nth harmonic, so this can give a sine any mix of harmonics, and other signals richer versions of themselves.
+	This uses floats, so call it in setup() or rarely.
+	@param levels the level of each harmonic, starting with the fundamental (T_1).
+	The curve is scaled down if needed so it stays within full scale.
+	@param num_levels how many levels there are.
+	*/
+	void setChebyshev(const float * levels, uint8_t num_levels)
+	{
+		float total = 0;
+		for (uint8_t k = 0; k < num_levels; ++k) total += fabsf(levels[k]);
+		const float norm = 32767.f / ((total > 1.f) ? total : 1.f);
+		for (uint16_t i = 0; i < NUM_CELLS; ++i)
+		{
+			float t_prev = 1.f, t = x(i), y = 0; // T_0 and T_1
+			for (uint8_t k = 0; k < num_levels; ++k)
+			{
+				y += levels[k] * t;
+				float t_next = 2.f * x(i) * t - t_prev;
+				t_prev = t;
+				t = t_next;
+			}
+			table[i] = (int16_t) (y * norm);
+		}
+	}
+
+
+	/** Copy a table into this shaper, from flash or RAM.
+	@param TABLE_NAME the table, with NUM_CELLS cells from the output for -32768 to the output for 32767.
+	*/
+	void setTable(const int16_t * TABLE_NAME)
+	{
+		for (uint16_t i = 0; i < NUM_CELLS; ++i) table[i] = FLASH_OR_RAM_READ<const int16_t>(TABLE_NAME + i);
+	}
+
+
+	/** Set one cell of the table, for drawing curves of your own.
+	@param index which cell, from 0 for an input of -32768 to NUM_CELLS-1 for 32767.
+	@param value the output for that input.
+	*/
+	inline
+	void setCell(uint16_t index, int16_t value)
+	{
+		table[index] = value;
+	}
+
+
+	/** Map an input to the output, interpolating between the two nearest cells of the table.
+	@param in the input signal, 16 bits.  Anything beyond -32768 to 32767 is limited to that range.
+	@return the shaped signal, 16 bits.
+	*/
+	inline
+	int next(int in)
+	{
+		uint16_t u = (uint16_t) ((int32_t) constrain(in, -32768L, 32767L) + 32768L);
+		uint16_t index = u >> (16 - INDEX_BITS);
+		uint8_t fraction = (INDEX_BITS <= 8) ? (uint8_t) (u >> (8 - INDEX_BITS_LOW)) : (uint8_t) (u << (INDEX_BITS_HIGH - 8));
+		int16_t a = table[index];
+		int16_t b = table[index + 1];
+		return a + (int) ((((int32_t) b - a) * fraction) >> 8);
+	}
+
+
+private:
+	static const uint8_t INDEX_BITS = trailingZerosConst(NUM_CELLS - 1);
+	// INDEX_BITS limited to each side of 8, so the shift which isn't used can't be negative
+	static const uint8_t INDEX_BITS_LOW = (INDEX_BITS <= 8) ? INDEX_BITS : 8;
+	static const uint8_t INDEX_BITS_HIGH = (INDEX_BITS > 8) ? INDEX_BITS : 8;
+
+	int16_t table[NUM_CELLS];
+
+
+	// the input for a cell, from -1 to 1
+	static inline float x(uint16_t i)
+	{
+		return (float) i * (2.f / (NUM_CELLS - 1)) - 1.f;
+	}
+};
+
+
 /** @example 06.Synthesis/WaveShaper/WaveShaper.ino
 This is an example of how to use the WaveShaper class.
 */
+
+/** @example 06.Synthesis/Waveshaper_Curves/Waveshaper_Curves.ino
+This is an example of how to use the InterpolatingWaveShaper class.
+*/
 #endif /* WAVESHAPER_H_ */
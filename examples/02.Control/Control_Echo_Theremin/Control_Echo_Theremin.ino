@@ -49,7 +49,7 @@ Oscil <SIN2048_NUM_CELLS, MOZZI_AUDIO_RATE> aSin2(SIN2048_DATA);
 Oscil <SIN2048_NUM_CELLS, MOZZI_AUDIO_RATE> aSin3(SIN2048_DATA);
 
 // use: RollingAverage <number_type, how_many_to_average> myThing
-RollingAverage <int, 32> kAverage; // how_many_to_average has to be power of 2
+RollingAverage <int, 32> kAverage; // how_many_to_average can be any number, but a power of 2 is quickest
 int averaged;
 
 void setup(){
@@ -49,7 +49,7 @@ void setup(){
 void updateControl(){
   // gain shifted up to give enough range for line's internal steps
    unsigned int gain = (128u+kTremelo.next())<<8;
-   aGain.set(gain, MOZZI_AUDIO_RATE / MOZZI_CONTROL_RATE); // divide of literals should get optimised away
+   aGain.setTarget<MOZZI_AUDIO_RATE / MOZZI_CONTROL_RATE>(gain); // a constant number of steps, so no division
 }
 
 
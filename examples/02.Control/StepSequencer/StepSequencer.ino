@@ -0,0 +1,115 @@
+/*  Example of three tracks of notes played from patterns in flash by a StepSequencer,
+    using Mozzi sonification library.
+
+    A melody of 16 steps, a bass line of 12 and a blip of 7 go round
+    together, drifting in and out of phase as polymeters.
+    The sequencer calls noteOn() for each note in the control step before
+    it starts, with the number of samples until the note's step begins,
+    and updateAudio() counts those down to start the note on the exact sample.
+
+    Circuit: Audio output on digital pin 9 on a Uno or similar, or
+    DAC/A14 on Teensy 3.1, or
+    check the README or http://sensorium.github.io/Mozzi/
+
+   Mozzi documentation/API
+   https://sensorium.github.io/Mozzi/doc/html/index.html
+
+   Mozzi help/discussion/announcements:
+   https://groups.google.com/forum/#!forum/mozzi-users
+
+   Copyright 2012-2024 Tim Barrass and the Mozzi Team
+
+   Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+*/
+
+#include <Mozzi.h>
+#include <Oscil.h> // oscillator template
+#include <tables/sin2048_int8.h> // sine table for oscillator
+#include <tables/triangle2048_int8.h> // triangle table for oscillator
+#include <mozzi_midi.h>
+#include <StepSequencer.h>
+
+#define NUM_TRACKS 3
+
+// each step is sequencerNote(midi_note, velocity) or SEQUENCER_REST, kept in flash
+CONSTTABLE_STORAGE(uint16_t) MELODY[16] = {
+  sequencerNote(72, 255), SEQUENCER_REST, sequencerNote(75, 160), SEQUENCER_REST,
+  sequencerNote(79, 200), sequencerNote(77, 120), SEQUENCER_REST, sequencerNote(75, 160),
+  sequencerNote(72, 255), SEQUENCER_REST, sequencerNote(70, 160), SEQUENCER_REST,
+  sequencerNote(67, 200), SEQUENCER_REST, sequencerNote(70, 120), SEQUENCER_REST
+};
+
+CONSTTABLE_STORAGE(uint16_t) BASS[12] = {
+  sequencerNote(36, 255), SEQUENCER_REST, SEQUENCER_REST, sequencerNote(36, 160),
+  SEQUENCER_REST, SEQUENCER_REST, sequencerNote(43, 220), SEQUENCER_REST,
+  SEQUENCER_REST, sequencerNote(41, 220), SEQUENCER_REST, SEQUENCER_REST
+};
+
+CONSTTABLE_STORAGE(uint16_t) BLIP[7] = {
+  sequencerNote(96, 180), SEQUENCER_REST, SEQUENCER_REST, sequencerNote(91, 120),
+  SEQUENCER_REST, SEQUENCER_REST, SEQUENCER_REST
+};
+
+Oscil <SIN2048_NUM_CELLS, MOZZI_AUDIO_RATE> aMelody(SIN2048_DATA);
+Oscil <TRIANGLE2048_NUM_CELLS, MOZZI_AUDIO_RATE> aBass(TRIANGLE2048_DATA);
+Oscil <SIN2048_NUM_CELLS, MOZZI_AUDIO_RATE> aBlip(SIN2048_DATA);
+
+// each voice's next note waits here until its countdown reaches 0
+int pending_freq[NUM_TRACKS];
+byte pending_velocity[NUM_TRACKS];
+uint16_t countdown[NUM_TRACKS];
+bool waiting[NUM_TRACKS];
+
+byte gain[NUM_TRACKS]; // set on the exact sample a note starts, then decayed in updateControl()
+
+
+void noteOn(uint8_t track, uint8_t note, uint8_t velocity, uint16_t delay_ticks){
+  pending_freq[track] = mtof(note);
+  pending_velocity[track] = velocity;
+  countdown[track] = delay_ticks;
+  waiting[track] = true;
+}
+
+// use: StepSequencer <how_many_tracks> myThing(callback, bpm)
+StepSequencer <NUM_TRACKS> kSequencer(noteOn, 112);
+
+
+void setup(){
+  kSequencer.setPattern(0, MELODY, 16);
+  kSequencer.setPattern(1, BASS, 12);
+  kSequencer.setPattern(2, BLIP, 7);
+  startMozzi();
+  kSequencer.start();
+}
+
+
+void updateControl(){
+  kSequencer.update();
+  gain[0] = ((int) gain[0] * 230) >> 8;
+  gain[1] = ((int) gain[1] * 245) >> 8;
+  gain[2] = ((int) gain[2] * 180) >> 8;
+}
+
+
+// start a voice's note when its countdown runs out
+inline void startOnTime(byte track){
+  if (waiting[track] && countdown[track]-- == 0){
+    waiting[track] = false;
+    gain[track] = pending_velocity[track];
+    if (track == 0) aMelody.setFreq(pending_freq[0]);
+    else if (track == 1) aBass.setFreq(pending_freq[1]);
+    else aBlip.setFreq(pending_freq[2]);
+  }
+}
+
+
+AudioOutput updateAudio(){
+  for (byte t = 0; t < NUM_TRACKS; t++) startOnTime(t);
+  int out = ((aMelody.next() * gain[0]) >> 2) + ((aBass.next() * gain[1]) >> 2) + ((aBlip.next() * gain[2]) >> 2);
+  return MonoOutput::fromNBit(16, out);
+}
+
+
+void loop(){
+  audioHook();
+}
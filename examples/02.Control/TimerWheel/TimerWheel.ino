@@ -0,0 +1,89 @@
+/*  Example of three repeating beats and a tempo change scheduled with one TimerWheel,
+    using Mozzi sonification library.
+
+    Three sine blips play at 3, 4 and 5 beats per bar, each from a repeating timer
+    which calls a function to start its envelope.  The fastest has swing,
+    delaying every second beat.  A fourth timer, without a callback, is checked with
+    ready() to change the tempo every few seconds, with setPeriod(), which
+    changes the beats' periods without restarting them.
+    The wheel is updated once in updateControl(), however many timers it has.
+
+    Circuit: Audio output on digital pin 9 on a Uno or similar, or
+    DAC/A14 on Teensy 3.1, or
+    check the README or http://sensorium.github.io/Mozzi/
+
+   Mozzi documentation/API
+   https://sensorium.github.io/Mozzi/doc/html/index.html
+
+   Mozzi help/discussion/announcements:
+   https://groups.google.com/forum/#!forum/mozzi-users
+
+   Copyright 2012-2024 Tim Barrass and the Mozzi Team
+
+   Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+*/
+
+#include <Mozzi.h>
+#include <Oscil.h> // oscillator template
+#include <tables/sin2048_int8.h> // sine table for oscillator
+#include <Ead.h> // exponential attack decay
+#include <TimerWheel.h>
+
+#define NUM_VOICES 3
+#define TEMPO_TIMER NUM_VOICES
+
+Oscil <SIN2048_NUM_CELLS, MOZZI_AUDIO_RATE> aSin[NUM_VOICES] = {
+  Oscil <SIN2048_NUM_CELLS, MOZZI_AUDIO_RATE> (SIN2048_DATA),
+  Oscil <SIN2048_NUM_CELLS, MOZZI_AUDIO_RATE> (SIN2048_DATA),
+  Oscil <SIN2048_NUM_CELLS, MOZZI_AUDIO_RATE> (SIN2048_DATA)
+};
+Ead kEnvelope[NUM_VOICES] = {Ead(MOZZI_CONTROL_RATE), Ead(MOZZI_CONTROL_RATE), Ead(MOZZI_CONTROL_RATE)};
+byte gain[NUM_VOICES];
+
+// use: TimerWheel <how_many_timers> myThing
+TimerWheel <NUM_VOICES + 1> kTimers;
+
+const byte BEATS_PER_BAR[NUM_VOICES] = {3, 4, 5};
+unsigned int bar_ms = 2400;
+
+
+// called by kTimers.update() when one of the beats is due
+void beat(uint8_t voice){
+  kEnvelope[voice].start(5, 120);
+}
+
+
+void setup(){
+  aSin[0].setFreq(220);
+  aSin[1].setFreq(330);
+  aSin[2].setFreq(495);
+  for (byte v = 0; v < NUM_VOICES; v++){
+    kTimers.setCallback(v, beat);
+    kTimers.start(v, bar_ms / BEATS_PER_BAR[v], true);
+  }
+  kTimers.setSwing(2, 60);
+  kTimers.start(TEMPO_TIMER, 7000, true);
+  startMozzi();
+}
+
+
+void updateControl(){
+  kTimers.update();
+  if (kTimers.ready(TEMPO_TIMER)){
+    bar_ms = (bar_ms > 1600) ? bar_ms - 400 : 2400;
+    for (byte v = 0; v < NUM_VOICES; v++) kTimers.setPeriod(v, bar_ms / BEATS_PER_BAR[v]);
+  }
+  for (byte v = 0; v < NUM_VOICES; v++) gain[v] = kEnvelope[v].next();
+}
+
+
+AudioOutput updateAudio(){
+  int out = 0;
+  for (byte v = 0; v < NUM_VOICES; v++) out += (aSin[v].next() * gain[v]) >> 2;
+  return MonoOutput::fromNBit(16, out);
+}
+
+
+void loop(){
+  audioHook();
+}
@@ -0,0 +1,54 @@
+/*  Test of audio input with the DC offset taken away, using Mozzi sonification library.
+
+ An audio input using the range between 0 to 5V on analog pin A0 (or as
+ set in MOZZI_AUDIO_INPUT_PIN) is read at 8 bits, and DCblocker8 removes
+ its offset, which is wherever the input circuit biases it, and the
+ lowest rumble, leaving a signal centred on 0 to output on digital pin 9.
+ DCblocker8 only uses shifts and adds, so it costs little on AVR.
+
+ NOTE: MOZZI_AUDIO_INPUT_STANDARD is not available as an option on all
+ platforms.
+
+ Circuit:
+ Audio cable centre wire on pin A0, outer shielding to Arduino Ground.
+ Audio output on DAC/A14 on Teensy 3.0, 3.1, or digital pin 9 on a Uno or similar, or
+ check the README or http://sensorium.github.io/Mozzi/
+
+   Mozzi documentation/API
+   https://sensorium.github.io/Mozzi/doc/html/index.html
+
+   Mozzi help/discussion/announcements:
+   https://groups.google.com/forum/#!forum/mozzi-users
+
+   Copyright 2013-2024 Tim Barrass and the Mozzi Team
+
+   Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+*/
+
+#include <MozziConfigValues.h>
+#define MOZZI_AUDIO_INPUT MOZZI_AUDIO_INPUT_STANDARD
+#define MOZZI_AUDIO_INPUT_PIN 0
+
+#include <Mozzi.h>
+#include <DCfilter.h>
+
+DCblocker8 <7> dcBlock; // blocks below about 20 Hz at 16384 Hz
+
+void setup(){
+  startMozzi();
+}
+
+
+void updateControl(){
+}
+
+
+AudioOutput updateAudio(){
+  int asig = dcBlock.next(getAudioInput<8>()); // now centred on 0, -128 to 127 for a full scale input
+  return MonoOutput::fromNBit(8, asig).clip();
+}
+
+
+void loop(){
+  audioHook();
+}
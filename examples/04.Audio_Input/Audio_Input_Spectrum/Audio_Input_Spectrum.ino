@@ -0,0 +1,91 @@
+/*  Example of spectral analysis of audio input,
+    using Mozzi sonification library.
+
+    A sine follows the loudest frequency in the input, found with FixedFFT,
+    and three more sines, on the notes of an A major chord, each play as loud
+    as that note is in the input, measured with a GoertzelBank.
+    The samples are written to the analysers in updateAudio(), and the
+    analysis is done a little at a time in loop(), between calls to audioHook().
+
+    NOTE: MOZZI_AUDIO_INPUT_STANDARD is not available as an option on all
+    platforms.
+
+    Circuit:
+    Audio cable centre wire on pin A0, outer shielding to Arduino Ground.
+    Audio output on DAC/A14 on Teensy 3.0, 3.1, or digital pin 9 on a Uno or similar, or
+    check the README or http://sensorium.github.io/Mozzi/
+
+   Mozzi documentation/API
+   https://sensorium.github.io/Mozzi/doc/html/index.html
+
+   Mozzi help/discussion/announcements:
+   https://groups.google.com/forum/#!forum/mozzi-users
+
+   Copyright 2012-2024 Tim Barrass and the Mozzi Team
+
+   Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+*/
+
+#include <MozziConfigValues.h>
+#define MOZZI_AUDIO_INPUT MOZZI_AUDIO_INPUT_STANDARD
+#define MOZZI_AUDIO_INPUT_PIN 0
+
+#include <Mozzi.h>
+#include <Oscil.h>
+#include <Spectrum.h>
+#include <tables/sin2048_int8.h>
+
+// smaller blocks on AVR, where RAM and time are short
+#if IS_AVR()
+const uint16_t FFT_SIZE = 64;
+const uint16_t GOERTZEL_SIZE = 256;
+#else
+const uint16_t FFT_SIZE = 256;
+const uint16_t GOERTZEL_SIZE = 1024;
+#endif
+
+FixedFFT <FFT_SIZE> fft;
+GoertzelBank <3, GOERTZEL_SIZE, MOZZI_AUDIO_RATE> notes;
+const uint16_t note_freqs[3] = {440, 554, 659}; // A4, C#5, E5
+
+Oscil <SIN2048_NUM_CELLS, MOZZI_AUDIO_RATE> aFollow(SIN2048_DATA);
+Oscil <SIN2048_NUM_CELLS, MOZZI_AUDIO_RATE> aNotes[3] = {SIN2048_DATA, SIN2048_DATA, SIN2048_DATA};
+uint8_t note_gains[3];
+
+
+void setup(){
+  for (uint8_t i = 0; i < 3; ++i) {
+    notes.setFreq(i, note_freqs[i]);
+    aNotes[i].setFreq((int) note_freqs[i]);
+  }
+  startMozzi();
+}
+
+
+void updateControl(){
+}
+
+
+AudioOutput updateAudio(){
+  int in = (int16_t) (getAudioInput<16>() ^ 0x8000); // flipping the top bit centres it on 0, -32768 to 32767
+  fft.write(in);
+  notes.write(in);
+  int out = aFollow.next() << 1;
+  for (uint8_t i = 0; i < 3; ++i) out += (aNotes[i].next() * note_gains[i]) >> 8;
+  return MonoOutput::fromNBit(10, out).clip();
+}
+
+
+void loop(){
+  audioHook(); // required here
+  if (fft.update()) {
+    // bin k is centred on k * MOZZI_AUDIO_RATE / FFT_SIZE Hz
+    aFollow.setFreq((int) ((uint32_t) fft.peakBin() * MOZZI_AUDIO_RATE / FFT_SIZE));
+    fft.start();
+  }
+  if (notes.update()) {
+    for (uint8_t i = 0; i < 3; ++i) {
+      note_gains[i] = notes.magnitude(i) >> 7; // up to about 32767 for a full scale sine
+    }
+  }
+}
@@ -0,0 +1,70 @@
+/*  Example of steadying three analog inputs with DecimatingAverage,
+    using Mozzi sonification library.
+
+    Each input is read at every updateControl(), and averaged over
+    blocks of 10 readings, a window length which needn't be a power of two.
+    The averages only change once every 10 control steps, when a block is
+    complete, and the averager keeps only a running total, not the readings.
+    Two inputs set the frequencies of two sine waves, and the third sets
+    how loud the second one is.
+
+    Circuit: potentiometers or other sensors on analog pins 0, 1 and 2.
+    Audio output on digital pin 9 on a Uno or similar, or
+    DAC/A14 on Teensy 3.1, or
+    check the README or http://sensorium.github.io/Mozzi/
+
+   Mozzi documentation/API
+   https://sensorium.github.io/Mozzi/doc/html/index.html
+
+   Mozzi help/discussion/announcements:
+   https://groups.google.com/forum/#!forum/mozzi-users
+
+   Copyright 2013-2024 Tim Barrass and the Mozzi Team
+
+   Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+*/
+
+#include <Mozzi.h>
+#include <Oscil.h> // oscillator template
+#include <tables/sin2048_int8.h> // sine table for oscillator
+#include <RollingAverage.h>
+
+#define FREQ_PIN_0 0
+#define FREQ_PIN_1 1
+#define LEVEL_PIN 2
+
+Oscil <SIN2048_NUM_CELLS, MOZZI_AUDIO_RATE> aSin0(SIN2048_DATA);
+Oscil <SIN2048_NUM_CELLS, MOZZI_AUDIO_RATE> aSin1(SIN2048_DATA);
+
+// use: DecimatingAverage <number_type, how_many_to_average> myThing
+DecimatingAverage <unsigned int, 10> kFreq0;
+DecimatingAverage <unsigned int, 10> kFreq1;
+DecimatingAverage <unsigned int, 10> kLevel;
+
+byte level;
+
+void setup(){
+  startMozzi();
+}
+
+
+void updateControl(){
+  kFreq0.update(mozziAnalogRead<10>(FREQ_PIN_0));
+  kFreq1.update(mozziAnalogRead<10>(FREQ_PIN_1));
+  // the three averagers always finish their blocks together, so only the last one needs checking
+  if (kLevel.update(mozziAnalogRead<10>(LEVEL_PIN))) {
+    aSin0.setFreq((int) kFreq0.get() + 100);
+    aSin1.setFreq((int) kFreq1.get() + 100);
+    level = kLevel.get() >> 2;
+  }
+}
+
+
+AudioOutput updateAudio(){
+  return MonoOutput::fromNBit(16, ((int) aSin0.next() << 7) + ((aSin1.next() * level) >> 1));
+}
+
+
+void loop(){
+  audioHook();
+}
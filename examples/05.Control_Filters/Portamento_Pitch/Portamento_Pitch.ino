@@ -0,0 +1,75 @@
+/*  Example of two voices sliding between notes in pitch,
+    using Mozzi sonification library.
+
+    Demonstrates Portamento with PORTAMENTO_PITCH, which slides
+    the same number of semitones each control step, so slides
+    sound even going up or down, where the default
+    PORTAMENTO_FREQUENCY slides in Hz and lingers at the bottom.
+    Starting a slide doesn't divide, so several voices can
+    change notes together without a spike in control-rate time.
+
+    Circuit: Audio output on digital pin 9 on a Uno or similar, or
+    DAC/A14 on Teensy 3.1, or
+    check the README or http://sensorium.github.io/Mozzi/
+
+   Mozzi documentation/API
+   https://sensorium.github.io/Mozzi/doc/html/index.html
+
+   Mozzi help/discussion/announcements:
+   https://groups.google.com/forum/#!forum/mozzi-users
+
+   Copyright 2013-2024 Tim Barrass and the Mozzi Team
+
+   Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+*/
+
+#include <Mozzi.h>
+#include <Oscil.h> // oscillator template
+#include <tables/sin2048_int8.h> // sine table for oscillator
+#include <EventDelay.h>
+#include <Portamento.h>
+
+Oscil <SIN2048_NUM_CELLS, MOZZI_AUDIO_RATE> aLow(SIN2048_DATA);
+Oscil <SIN2048_NUM_CELLS, MOZZI_AUDIO_RATE> aHigh(SIN2048_DATA);
+
+// use: Portamento <update_rate, mode> myThing
+Portamento <MOZZI_CONTROL_RATE, PORTAMENTO_PITCH> kLowGlide;
+Portamento <MOZZI_CONTROL_RATE, PORTAMENTO_PITCH> kHighGlide;
+
+EventDelay kNoteDelay;
+
+const byte LOW_NOTES[] = {48, 55, 41, 60, 36, 53};
+const byte HIGH_NOTES[] = {76, 67, 84, 72, 79, 64};
+byte note_index = 0;
+
+
+void setup(){
+  kLowGlide.setTime(400);
+  kHighGlide.setTime(150);
+  kLowGlide.start(LOW_NOTES[0]);
+  kHighGlide.start(HIGH_NOTES[0]);
+  kNoteDelay.start(900);
+  startMozzi();
+}
+
+
+void updateControl(){
+  if (kNoteDelay.ready()){
+    if (++note_index >= sizeof(LOW_NOTES)) note_index = 0;
+    kLowGlide.start(LOW_NOTES[note_index]);
+    kHighGlide.start(HIGH_NOTES[note_index]);
+    kNoteDelay.start();
+  }
+  aLow.setFreq_Q16n16(kLowGlide.next());
+  aHigh.setFreq_Q16n16(kHighGlide.next());
+}
+
+
+AudioOutput updateAudio(){
+  return MonoOutput::fromNBit(9, aLow.next() + (aHigh.next() >> 1));
+}
+
+
+void loop(){
+  audioHook();
+}
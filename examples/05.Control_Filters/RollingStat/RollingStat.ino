@@ -0,0 +1,73 @@
+/*  Example of following the movement of a sensor with RollingStat,
+    using Mozzi sonification library.
+
+    An analog input, such as an accelerometer axis or a light sensor,
+    is read at control rate, and RollingStat follows its statistics over
+    the last half second or so.  The mean sets the pitch of a sine,
+    the standard deviation, which rises when the sensor is moved about,
+    sets its volume, and the range between the minimum and maximum
+    sets the depth of a vibrato.  Keep the sensor still for silence.
+
+    Circuit: Audio output on digital pin 9 on a Uno or similar, or
+    DAC/A14 on Teensy 3.1, or
+    check the README or http://sensorium.github.io/Mozzi/
+
+   Mozzi documentation/API
+   https://sensorium.github.io/Mozzi/doc/html/index.html
+
+   Mozzi help/discussion/announcements:
+   https://groups.google.com/forum/#!forum/mozzi-users
+
+   Copyright 2013-2024 Tim Barrass and the Mozzi Team
+
+   Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+*/
+
+#include <Mozzi.h>
+#include <Oscil.h> // oscillator template
+#include <tables/sin2048_int8.h> // sine table for oscillator
+#include <RollingStat.h>
+
+#define INPUT_PIN 0 // analog control input
+
+Oscil <SIN2048_NUM_CELLS, MOZZI_AUDIO_RATE> aSin(SIN2048_DATA);
+Oscil <SIN2048_NUM_CELLS, MOZZI_CONTROL_RATE> kVibrato(SIN2048_DATA);
+
+// use: RollingStat <number_type, how_many_to_include> myThing
+RollingStat <int, 32> kStat; // how_many_to_include has to be a power of 2
+byte volume;
+
+void setup(){
+  //Serial.begin(9600); // for Teensy 3.1, beware printout can cause glitches
+  Serial.begin(115200);
+  kVibrato.setFreq(6);
+  startMozzi();
+}
+
+
+void updateControl(){
+  kStat.update(mozziAnalogRead<10>(INPUT_PIN));
+
+  int spread = kStat.getStandardDeviation();
+  int range = kStat.getMax() - kStat.getMin();
+
+  Serial.print("mean \t");
+  Serial.print(kStat.getMean());
+  Serial.print("\t sd \t");
+  Serial.print(spread);
+  Serial.print("\t range \t");
+  Serial.println(range);
+
+  volume = (spread > 63) ? 255 : spread << 2;
+  aSin.setFreq(200 + kStat.getMean() + ((kVibrato.next() * (range >> 2)) >> 7));
+}
+
+
+AudioOutput updateAudio(){
+  return MonoOutput::from16Bit(aSin.next() * volume);
+}
+
+
+void loop(){
+  audioHook();
+}
@@ -0,0 +1,111 @@
+/*  Example of modulating a filtered saw wave with a bank of LFOs and an envelope,
+    routed through a modulation matrix, using Mozzi sonification library.
+
+    Three LFOs in an LFOBank and an ADSR envelope are the sources of a ModMatrix,
+    which adds them, at set depths, to the pitch, the filter cutoff and the level.
+    The matrix only calls a destination's setter when its value changes,
+    so the filter and oscillator are only set when they need to be.
+
+    Circuit: Audio output on digital pin 9 on a Uno or similar, or
+    DAC/A14 on Teensy 3.1, or
+    check the README or http://sensorium.github.io/Mozzi/
+
+   Mozzi documentation/API
+   https://sensorium.github.io/Mozzi/doc/html/index.html
+
+   Mozzi help/discussion/announcements:
+   https://groups.google.com/forum/#!forum/mozzi-users
+
+   Copyright 2012-2024 Tim Barrass and the Mozzi Team
+
+   Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+*/
+
+#include <Mozzi.h>
+#include <Oscil.h>
+#include <tables/saw2048_int8.h>
+#include <tables/sin2048_int8.h>
+#include <tables/triangle2048_int8.h>
+#include <ResonantFilter.h>
+#include <ADSR.h>
+#include <EventDelay.h>
+#include <ModMatrix.h>
+
+// the sources and destinations of the matrix
+enum {VIBRATO, SWEEP, TREMOLO, ENVELOPE, NUM_SOURCES};
+enum {PITCH, CUTOFF, LEVEL, NUM_DESTINATIONS};
+
+Oscil <SAW2048_NUM_CELLS, MOZZI_AUDIO_RATE> aSaw(SAW2048_DATA);
+LowPassFilter lpf;
+ADSR <MOZZI_CONTROL_RATE, MOZZI_CONTROL_RATE> kEnvelope;
+EventDelay kNoteDelay;
+
+// use: LFOBank <how_many_lfos, table_size, update_rate> myThing(table)
+LFOBank <3, SIN2048_NUM_CELLS, MOZZI_CONTROL_RATE> kLFOs(SIN2048_DATA);
+
+// use: ModMatrix <how_many_sources, how_many_destinations, most_routes> myThing
+ModMatrix <NUM_SOURCES, NUM_DESTINATIONS, 6> kMatrix;
+
+byte level;
+
+// the destinations' setters, called by kMatrix.update() only when their values change
+void setPitch(int freq){
+  aSaw.setFreq(freq);
+}
+
+void setCutoff(int cutoff){
+  lpf.setCutoffFreqAndResonance(cutoff, 200);
+}
+
+void setLevel(int new_level){
+  level = new_level;
+}
+
+
+void setup(){
+  kLFOs.setFreq_Q16n16(VIBRATO, float_to_Q16n16(5.5f));
+  kLFOs.setFreq_Q16n16(SWEEP, float_to_Q16n16(0.2f));
+  kLFOs.setTable(SWEEP, TRIANGLE2048_DATA);
+  kLFOs.setFreq_Q16n16(TREMOLO, float_to_Q16n16(3.f));
+  kLFOs.sync();
+
+  kEnvelope.setADLevels(255, 150);
+  kEnvelope.setTimes(20, 300, 400, 800);
+  kNoteDelay.set(2000);
+
+  kMatrix.setDestination(PITCH, setPitch, 110, 20, 2000);
+  kMatrix.setDestination(CUTOFF, setCutoff, 60, 10, 240);
+  kMatrix.setDestination(LEVEL, setLevel, 0, 0, 255);
+
+  // depths are Q7n8, so an LFO from -128 to 127 with a depth of 6 moves its destination about 3 either way
+  kMatrix.addRoute(VIBRATO, PITCH, 6);          // about 3Hz either way
+  kMatrix.addRoute(ENVELOPE, PITCH, -8);        // a little downward bend, up to 8Hz, while the envelope is high
+  kMatrix.addRoute(SWEEP, CUTOFF, 120);         // slow sweep of about 60 either way
+  kMatrix.addRoute(ENVELOPE, CUTOFF, 100);      // envelope opens the filter by up to 100
+  kMatrix.addRoute(ENVELOPE, LEVEL, 256);       // envelope sets the level
+  kMatrix.addRoute(TREMOLO, LEVEL, 48);         // with about 24 of tremolo on top
+  startMozzi();
+}
+
+
+void updateControl(){
+  if (kNoteDelay.ready()){
+    kEnvelope.noteOn();
+    kNoteDelay.start();
+  }
+  kLFOs.update();
+  for (byte i = 0; i < 3; i++) kMatrix.setSource(i, kLFOs.value(i));
+  kEnvelope.update();
+  kMatrix.setSource(ENVELOPE, kEnvelope.next());
+  kMatrix.update();
+}
+
+
+AudioOutput updateAudio(){
+  return MonoOutput::fromNBit(17, (int32_t) lpf.next(aSaw.next()) * level);
+}
+
+
+void loop(){
+  audioHook();
+}
@@ -0,0 +1,89 @@
+/*  Example of 16 bit waveshaping with curves made in setup(),
+    using Mozzi sonification library.
+
+    Demonstrates InterpolatingWaveShaper, with a tanh curve, a foldback curve
+    and a mix of Chebyshev polynomials, each a small table in RAM which is
+    interpolated to shape a full 16 bit signal smoothly.
+    The gain into the shapers rises and falls, so the sound goes from nearly
+    a pure sine to saturated, folded and harmonic versions of it.
+
+    Circuit: Audio output on digital pin 9 on a Uno or similar, or
+    DAC/A14 on Teensy 3.1, or
+    check the README or http://sensorium.github.io/Mozzi/
+
+   Mozzi documentation/API
+   https://sensorium.github.io/Mozzi/doc/html/index.html
+
+   Mozzi help/discussion/announcements:
+   https://groups.google.com/forum/#!forum/mozzi-users
+
+   Copyright 2012-2024 Tim Barrass and the Mozzi Team
+
+   Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+*/
+
+#include <Mozzi.h>
+#include <Oscil.h>
+#include <WaveShaper.h>
+#include <tables/sin2048_int8.h>
+
+Oscil <SIN2048_NUM_CELLS, MOZZI_AUDIO_RATE> aSin(SIN2048_DATA);
+Oscil <SIN2048_NUM_CELLS, MOZZI_CONTROL_RATE> kGain(SIN2048_DATA); // slow swell of the gain into the shapers
+Oscil <SIN2048_NUM_CELLS, MOZZI_CONTROL_RATE> kBlend(SIN2048_DATA); // crossfades between the shapers
+
+// small tables on AVR, where RAM is short, bigger elsewhere
+#if IS_AVR()
+const uint16_t CURVE_CELLS = 65;
+#else
+const uint16_t CURVE_CELLS = 257;
+#endif
+
+InterpolatingWaveShaper <CURVE_CELLS> aTanh;
+InterpolatingWaveShaper <CURVE_CELLS> aFold;
+InterpolatingWaveShaper <CURVE_CELLS> aCheby;
+
+const float harmonics[] = {0.5f, 0.f, 0.3f, 0.f, 0.2f}; // fundamental, 3rd and 5th harmonics
+
+uint8_t gain; // input gain, 7 fractional bits
+uint8_t blend;
+
+
+void setup(){
+  aTanh.setTanh(3.f);
+  aFold.setFoldback(3.f);
+  aCheby.setChebyshev(harmonics, 5);
+  aSin.setFreq(110);
+  kGain.setFreq(0.2f);
+  kBlend.setFreq(0.07f);
+  startMozzi();
+}
+
+
+void updateControl(){
+  gain = 128 + kGain.next();
+  blend = 128 + kBlend.next();
+}
+
+
+AudioOutput updateAudio(){
+  // gain up to almost 2, so the loudest part of the swell is clipped at the ends of the 16 bit input range,
+  // worked out in 32 bits as it overflows an int on AVR
+  int in = constrain(((int32_t) aSin.next() * gain) << 1, -32768L, 32767L);
+  // tanh to foldback as blend goes up to 127, then foldback to Chebyshev up to 255
+  int from, to;
+  if (blend < 128) {
+    from = aTanh.next(in);
+    to = aFold.next(in);
+  } else {
+    from = aFold.next(in);
+    to = aCheby.next(in);
+  }
+  uint8_t mix = (blend & 127) << 1;
+  // 16 bit signals, so the crossfade needs 32 bits on AVR
+  return MonoOutput::from16Bit((int) (((int32_t) from * (255 - mix) + (int32_t) to * mix) >> 8));
+}
+
+
+void loop(){
+  audioHook(); // required here
+}
@@ -0,0 +1,87 @@
+/*  Example of polyphonic envelopes with an ADSRBank,
+    using Mozzi sonification library.
+
+    Random notes are played on a handful of voices, each with its own
+    envelope from one ADSRBank, which updates all of them in one pass.
+    Low notes use a slow, swelling set of envelope settings,
+    and high notes a short, plucked one, shared by all the voices.
+
+   Mozzi documentation/API
+   https://sensorium.github.io/Mozzi/doc/html/index.html
+
+   Mozzi help/discussion/announcements:
+   https://groups.google.com/forum/#!forum/mozzi-users
+
+   Copyright 2013-2024 Tim Barrass and the Mozzi Team
+
+   Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+*/
+
+#include <Mozzi.h>
+#include <Oscil.h>
+#include <EventDelay.h>
+#include <ADSRBank.h>
+#include <tables/triangle2048_int8.h>
+#include <mozzi_rand.h>
+#include <mozzi_midi.h>
+
+#if IS_AVR()
+const uint8_t NUM_VOICES = 4;
+const uint8_t OUTPUT_BITS = 18; // 16 bits for each voice, and 2 more for adding 4 of them
+#else
+const uint8_t NUM_VOICES = 8;
+const uint8_t OUTPUT_BITS = 19;
+#endif
+
+enum {PAD, PLUCK}; // the two sets of envelope settings
+
+Oscil <TRIANGLE2048_NUM_CELLS, MOZZI_AUDIO_RATE> aVoices[NUM_VOICES];
+ADSRBank <NUM_VOICES, MOZZI_CONTROL_RATE, MOZZI_AUDIO_RATE, 2> envelopes;
+
+// for triggering notes
+EventDelay noteDelay;
+
+uint8_t next_voice = 0;
+
+void setup(){
+  randSeed(); // fresh random
+  for (uint8_t v = 0; v < NUM_VOICES; ++v) aVoices[v].setTable(TRIANGLE2048_DATA);
+  envelopes.setADLevels(200, 160, PAD);
+  envelopes.setTimes(800, 400, 1000, 1500, PAD);
+  envelopes.setADLevels(255, 40, PLUCK);
+  envelopes.setTimes(10, 150, 300, 400, PLUCK);
+  noteDelay.set(250);
+  startMozzi();
+}
+
+
+void updateControl(){
+  if(noteDelay.ready()){
+    // take an idle voice if there is one, or else the next in turn
+    int8_t voice = envelopes.idleVoice();
+    if (voice < 0) {
+      voice = next_voice;
+      if (++next_voice == NUM_VOICES) next_voice = 0;
+    }
+    byte midi_note = rand(36) + 36;
+    aVoices[voice].setFreq(mtof(midi_note));
+    envelopes.noteOn(voice, (midi_note < 54) ? PAD : PLUCK);
+    noteDelay.start(rand(400) + 100);
+  }
+  envelopes.update();
+}
+
+
+AudioOutput updateAudio(){
+  envelopes.next();
+  long out = 0;
+  for (uint8_t v = 0; v < NUM_VOICES; ++v) {
+    out += aVoices[v].next() * envelopes.level(v);
+  }
+  return MonoOutput::fromNBit(OUTPUT_BITS, out);
+}
+
+
+void loop(){
+  audioHook(); // required here
+}
@@ -0,0 +1,73 @@
+/*  Example of an ADSR envelope with curved segments,
+    using Mozzi sonification library.
+
+    Plucked notes, with an exponential attack, decay and release,
+    which fall away quickly and then ring on, like a string.
+    Every fourth note swells in with a logarithmic attack instead.
+    The envelope's 16 bit output from next16() keeps the quiet
+    end of the decays smooth.
+
+   Mozzi documentation/API
+   https://sensorium.github.io/Mozzi/doc/html/index.html
+
+   Mozzi help/discussion/announcements:
+   https://groups.google.com/forum/#!forum/mozzi-users
+
+   Copyright 2013-2024 Tim Barrass and the Mozzi Team
+
+   Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+*/
+
+#include <Mozzi.h>
+#include <Oscil.h>
+#include <EventDelay.h>
+#include <ADSR.h>
+#include <tables/saw2048_int8.h>
+#include <mozzi_rand.h>
+#include <mozzi_midi.h>
+
+Oscil <SAW2048_NUM_CELLS, MOZZI_AUDIO_RATE> aOscil(SAW2048_DATA);
+
+// for triggering the envelope
+EventDelay noteDelay;
+
+ADSR <MOZZI_CONTROL_RATE, MOZZI_AUDIO_RATE> envelope;
+
+byte note_count = 0;
+
+void setup(){
+  randSeed(); // fresh random
+  envelope.setADLevels(255, 60);
+  envelope.setTimes(20, 600, 200, 800);
+  envelope.setShapes(ADSR_EXPONENTIAL, ADSR_EXPONENTIAL, ADSR_LINEAR, ADSR_EXPONENTIAL);
+  noteDelay.set(1200);
+  startMozzi();
+}
+
+
+void updateControl(){
+  if(noteDelay.ready()){
+    if ((++note_count & 3) == 0) {
+      envelope.setAttackShape(ADSR_LOGARITHMIC);
+      envelope.setAttackTime(500);
+    } else {
+      envelope.setAttackShape(ADSR_EXPONENTIAL);
+      envelope.setAttackTime(20);
+    }
+    envelope.noteOn();
+    aOscil.setFreq(mtof(rand(36) + 36));
+    noteDelay.start(1200);
+  }
+  envelope.update();
+}
+
+
+AudioOutput updateAudio(){
+  // 8 bit oscillator times 16 bit envelope gives 24 bits
+  return MonoOutput::fromNBit(24, (int32_t) aOscil.next() * envelope.next16());
+}
+
+
+void loop(){
+  audioHook(); // required here
+}
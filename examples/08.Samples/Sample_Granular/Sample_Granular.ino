@@ -0,0 +1,86 @@
+/*  Example of a cloud of grains taken from a sampled sound,
+    using Mozzi sonification library.
+
+    Demonstrates Granulator, which plays many short, enveloped
+    grains from a sound table.  The grain start position wanders
+    slowly through the sample, while the density, duration and
+    pitch of the grains drift around.
+
+    Circuit: Audio output on digital pin 9 on a Uno or similar, or
+    DAC/A14 on Teensy 3.1, or
+    check the README or http://sensorium.github.io/Mozzi/
+
+   Mozzi documentation/API
+   https://sensorium.github.io/Mozzi/doc/html/index.html
+
+   Mozzi help/discussion/announcements:
+   https://groups.google.com/forum/#!forum/mozzi-users
+
+   Copyright 2012-2024 Tim Barrass and the Mozzi Team
+
+   Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+*/
+
+#include <Mozzi.h>
+#include <Granulator.h>
+#include <Oscil.h>
+#include <samples/burroughs1_18649_int8.h>
+#include <tables/halfsinwindow512_uint8.h>
+#include <tables/sin256_int8.h>
+#include <mozzi_rand.h>
+
+// use: Granulator <table_size, window_size, update_rate, max_grains> GranulatorName (sound table, window table)
+// only the first half of HALFSINWINDOW512 holds the half-sine window, the rest is silence
+Granulator <BURROUGHS1_18649_NUM_CELLS, HALFSINWINDOW512_NUM_CELLS/2, MOZZI_CONTROL_RATE, 8> aGrains(BURROUGHS1_18649_DATA, HALFSINWINDOW512_DATA);
+
+// slow drifts for the density and duration
+Oscil <SIN256_NUM_CELLS, MOZZI_CONTROL_RATE> kDensity(SIN256_DATA);
+Oscil <SIN256_NUM_CELLS, MOZZI_CONTROL_RATE> kDuration(SIN256_DATA);
+
+unsigned int position = 0;
+int last_density = 0;
+unsigned int last_duration = 0;
+
+
+void setup(){
+  randSeed(); // fresh randomness
+  kDensity.setFreq(0.13f);
+  kDuration.setFreq(0.07f);
+  aGrains.setPositionJitter(600);
+  aGrains.setPitchJitter(2000); // a little detuning between grains
+  aGrains.setTimingJitter(128);
+  startMozzi();
+}
+
+
+void updateControl(){
+  // creep through the sample
+  position += 20;
+  if (position >= BURROUGHS1_18649_NUM_CELLS) position -= BURROUGHS1_18649_NUM_CELLS;
+  aGrains.setPosition(position);
+
+  // setDensity() and setDuration() divide, so only call them when the drifting values move
+  int density = 40 + kDensity.next()/4; // 8 to 71 grains per second
+  if (density != last_density) {
+    aGrains.setDensity(density);
+    last_density = density;
+  }
+  unsigned int duration = 100 + kDuration.next()/2; // 36 to 163 ms
+  if (duration != last_duration) {
+    aGrains.setDuration(duration);
+    last_duration = duration;
+  }
+
+  if(!rand(MOZZI_CONTROL_RATE)) aGrains.setPitch_Q16n16(Q16n16_FIX1 >> rand((uint8_t)2)); // sometimes drop an octave
+  aGrains.update();
+}
+
+
+AudioOutput updateAudio(){
+  return MonoOutput::fromAlmostNBit(10, aGrains.next());
+}
+
+
+void loop(){
+  audioHook();
+}
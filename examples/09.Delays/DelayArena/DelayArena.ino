@@ -0,0 +1,83 @@
+/*  Example of several delays sharing one block of memory,
+    using Mozzi sonification library.
+
+    Demonstrates DelayArena, which carves delay lines of any length
+    out of one buffer.  Here a plucky synth goes through a short
+    slapback and a longer echo with feedback.  Every few seconds the
+    echo time changes, and the lines are rearranged in the arena
+    without needing any more memory.
+
+    Circuit: Audio output on digital pin 9 for STANDARD output on a Uno or similar, or
+    see the readme.md file for others.
+
+   Mozzi documentation/API
+   https://sensorium.github.io/Mozzi/doc/html/index.html
+
+   Mozzi help/discussion/announcements:
+   https://groups.google.com/forum/#!forum/mozzi-users
+
+   Copyright 2024 Tim Barrass and the Mozzi Team
+
+   Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+*/
+
+#include <Mozzi.h>
+#include <Oscil.h>
+#include <ADSR.h>
+#include <EventDelay.h>
+#include <DelayArena.h>
+#include <mozzi_rand.h>
+#include <tables/triangle2048_int8.h>
+
+Oscil <TRIANGLE2048_NUM_CELLS, MOZZI_AUDIO_RATE> aTri(TRIANGLE2048_DATA);
+ADSR <MOZZI_CONTROL_RATE, MOZZI_AUDIO_RATE> envelope;
+
+// 1200 bytes altogether: not a power of two, and fits on a Uno
+DelayArena <1200> arena;
+int8_t slapback, echo;
+
+EventDelay kNote;
+EventDelay kChangeEcho;
+const uint16_t echo_lengths[] = {1000, 733, 1111, 500};
+uint8_t echo_choice = 0;
+
+
+void setup(){
+  envelope.setADLevels(255, 100);
+  envelope.setTimes(5, 80, 50, 200);
+  slapback = arena.addLine(97);
+  echo = arena.addLine(echo_lengths[0]);
+  kNote.set(250);
+  kChangeEcho.set(4000);
+  startMozzi();
+}
+
+
+void updateControl(){
+  if (kNote.ready()) {
+    aTri.setFreq((int)(110 << rand(3)));
+    envelope.noteOn();
+    kNote.start();
+  }
+  if (kChangeEcho.ready()) {
+    echo_choice = (echo_choice + 1) & 3;
+    arena.setLength(echo, echo_lengths[echo_choice]);
+    kChangeEcho.start();
+  }
+  envelope.update();
+}
+
+
+AudioOutput updateAudio(){
+  int8_t dry = (int8_t)((aTri.next() * (int)envelope.next()) >> 9);
+  int8_t slap = arena.next(slapback, dry);
+  // feed half of the echo back into itself
+  int8_t echoed = arena.read(echo, arena.getLength(echo));
+  arena.write(echo, (int8_t)((dry + slap + echoed) >> 1));
+  return MonoOutput::fromNBit(9, (int)dry + slap + echoed);
+}
+
+
+void loop(){
+  audioHook();
+}
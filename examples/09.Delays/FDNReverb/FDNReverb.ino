@@ -0,0 +1,91 @@
+/*  Example of a feedback delay network reverb on a synthesised sound
+    using Mozzi sonification library.
+
+    Demonstrates FDNReverb, a reverb made of 4 or 8 delay lines of prime
+    lengths which feed back into each other through a mixing matrix.
+    The amount of memory it uses is set by its first template parameter,
+    so the same sketch makes a small room on a Uno and a large hall on
+    boards with more RAM.
+    The size of the room slowly sweeps up and down, and the decay and
+    damping can be changed during run time too.
+    The synthesised sound comes from the phasemod synth example.
+
+    Circuit: Audio output on digital pin 9 for STANDARD output on a Uno or similar, or
+    see the readme.md file for others.
+
+   Mozzi documentation/API
+   https://sensorium.github.io/Mozzi/doc/html/index.html
+
+   Mozzi help/discussion/announcements:
+   https://groups.google.com/forum/#!forum/mozzi-users
+
+   Copyright 2024 Tim Barrass and the Mozzi Team
+
+   Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+*/
+
+#define MOZZI_CONTROL_RATE 64 // quite fast, keeps modulation smooth
+#include <Mozzi.h>
+#include <FDNReverb.h>
+#include <Oscil.h>
+#include <tables/cos8192_int8.h>
+#include <tables/envelop2048_uint8.h>
+
+#if IS_AVR()
+FDNReverb <512> reverb(200, 96); // 1 kB of RAM, 4 lines
+#else
+FDNReverb <16384, 8> reverb(235, 64); // 32 kB of RAM, 8 lines
+#endif
+
+// Synth from PhaseMod_Envelope example
+Oscil <COS8192_NUM_CELLS, MOZZI_AUDIO_RATE> aCarrier(COS8192_DATA);
+Oscil <COS8192_NUM_CELLS, MOZZI_AUDIO_RATE> aModulator(COS8192_DATA);
+Oscil <COS8192_NUM_CELLS, MOZZI_AUDIO_RATE> aModWidth(COS8192_DATA);
+Oscil <COS8192_NUM_CELLS, MOZZI_CONTROL_RATE> kModFreq1(COS8192_DATA);
+Oscil <COS8192_NUM_CELLS, MOZZI_CONTROL_RATE> kModFreq2(COS8192_DATA);
+Oscil <ENVELOP2048_NUM_CELLS, MOZZI_AUDIO_RATE> aEnvelop(ENVELOP2048_DATA);
+Oscil <COS8192_NUM_CELLS, MOZZI_CONTROL_RATE> kSize(COS8192_DATA);
+
+uint8_t room_size = 255;
+
+
+void setup(){
+  // synth params
+  aCarrier.setFreq(55);
+  kModFreq1.setFreq(3.98f);
+  kModFreq2.setFreq(3.31757f);
+  aModWidth.setFreq(2.52434f);
+  aEnvelop.setFreq(9.0f);
+  kSize.setFreq(0.05f);
+
+  startMozzi();
+}
+
+
+void updateControl(){
+  // synth control
+  aModulator.setFreq(277.0f + 0.4313f*kModFreq1.next() + kModFreq2.next());
+
+  // setSize() looks up new prime lengths, so only call it when the size really changes
+  uint8_t new_size = 191 + (kSize.next()>>1);
+  if (new_size != room_size) {
+    room_size = new_size;
+    reverb.setSize(room_size);
+  }
+}
+
+
+AudioOutput updateAudio(){
+  int synth = aCarrier.phMod((int)aModulator.next()*(150u+aModWidth.next()));
+  synth *= (byte)aEnvelop.next();
+  synth >>= 8;
+  // here's the reverb, left() and right() would give a stereo version
+  int arev = reverb.next(synth);
+  // add the dry and wet signals
+  return MonoOutput::fromAlmostNBit(9, synth + (arev>>1));
+}
+
+
+void loop(){
+  audioHook();
+}
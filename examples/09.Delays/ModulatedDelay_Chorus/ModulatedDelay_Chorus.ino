@@ -0,0 +1,77 @@
+/*  Example of a chorus and a flanger on a synthesised sound
+    using Mozzi sonification library.
+
+    Demonstrates ModulatedDelay, a delay line swept by its own LFO,
+    with interpolated taps so the delay time slides smoothly.
+    A 2-tap chorus thickens a slightly detuned saw chord, then a
+    1-tap flanger with feedback sweeps over the result.
+    The left() and right() outputs of the chorus would give a
+    stereo spread, here they're mixed down to mono.
+
+    Circuit: Audio output on digital pin 9 for STANDARD output on a Uno or similar, or
+    see the readme.md file for others.
+
+   Mozzi documentation/API
+   https://sensorium.github.io/Mozzi/doc/html/index.html
+
+   Mozzi help/discussion/announcements:
+   https://groups.google.com/forum/#!forum/mozzi-users
+
+   Copyright 2024 Tim Barrass and the Mozzi Team
+
+   Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+*/
+
+#include <Mozzi.h>
+#include <Oscil.h>
+#include <ModulatedDelay.h>
+#include <EventDelay.h>
+#include <tables/saw2048_int8.h>
+
+Oscil <SAW2048_NUM_CELLS, MOZZI_AUDIO_RATE> aSaw1(SAW2048_DATA);
+Oscil <SAW2048_NUM_CELLS, MOZZI_AUDIO_RATE> aSaw2(SAW2048_DATA);
+
+ModulatedDelay <512> chorus; // 2 taps, int8_t cells
+ModulatedDelay <128, 1> flanger;
+
+EventDelay kChangeNote;
+const float notes[] = {110.f, 130.81f, 146.83f, 98.f};
+uint8_t note = 0;
+
+
+void setup(){
+  chorus.setDelayMs(12.f);
+  chorus.setDepthMs(4.f);
+  chorus.setLFOFreq(0.6f);
+
+  flanger.setDelayMs(0.5f);
+  flanger.setDepthMs(3.f);
+  flanger.setLFOFreq(0.15f);
+  flanger.setFeedbackLevel(90);
+
+  kChangeNote.set(1500);
+  startMozzi();
+}
+
+
+void updateControl(){
+  if (kChangeNote.ready()) {
+    aSaw1.setFreq(notes[note]);
+    aSaw2.setFreq(notes[note] * 1.004f);
+    note = (note + 1) & 3;
+    kChangeNote.start();
+  }
+}
+
+
+AudioOutput updateAudio(){
+  int dry = (aSaw1.next() + aSaw2.next()) >> 2;
+  int wet = dry + (chorus.next(dry) >> 1);
+  int flanged = wet + flanger.next(wet >> 1);
+  return MonoOutput::fromNBit(9, flanged);
+}
+
+
+void loop(){
+  audioHook();
+}
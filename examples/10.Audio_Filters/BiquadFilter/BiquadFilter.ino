@@ -0,0 +1,69 @@
+/*  Example of a crossover and an EQ made with biquad filters,
+    using Mozzi sonification library.
+
+    Demonstrates BiquadFilter and BiquadCoeffs.
+    A saw wave is split into low and high bands by a 4th order
+    Linkwitz-Riley crossover, which slowly sweeps up and down.
+    The high band gets a tremolo, then the bands are added back
+    together and a peaking EQ, designed at compile time, adds some bite.
+
+    Circuit: Audio output on digital pin 9 on a Uno or similar, or
+    DAC/A14 on Teensy 3.1, or
+    check the README or http://sensorium.github.io/Mozzi/
+
+   Mozzi documentation/API
+   https://sensorium.github.io/Mozzi/doc/html/index.html
+
+   Mozzi help/discussion/announcements:
+   https://groups.google.com/forum/#!forum/mozzi-users
+
+   Copyright 2024 Tim Barrass and the Mozzi Team
+
+   Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+*/
+
+#include <Mozzi.h>
+#include <Oscil.h>
+#include <BiquadFilter.h>
+#include <tables/saw2048_int8.h>
+#include <tables/sin2048_int8.h>
+
+Oscil<SAW2048_NUM_CELLS, MOZZI_AUDIO_RATE> aSaw(SAW2048_DATA);
+Oscil<SIN2048_NUM_CELLS, MOZZI_CONTROL_RATE> kTremolo(SIN2048_DATA);
+Oscil<SIN2048_NUM_CELLS, MOZZI_CONTROL_RATE> kSweep(SIN2048_DATA);
+
+BiquadFilter<2> lows; // two sections make a 4th order Linkwitz-Riley filter
+BiquadFilter<2> highs;
+BiquadFilter<1> eq;
+
+// all worked out when compiling, so no floats are used for this when the sketch runs
+constexpr BiquadCoeffs bite = BiquadCoeffs::peaking(2500, 1.5f, 9);
+
+uint8_t tremolo_level;
+
+void setup() {
+  aSaw.setFreq(65.f);
+  kTremolo.setFreq(6.f);
+  kSweep.setFreq(0.1f);
+  eq.setSection(0, bite);
+  startMozzi();
+}
+
+void loop() {
+  audioHook();
+}
+
+void updateControl() {
+  tremolo_level = 128 + kTremolo.next();
+  // the Hz versions use integers and a table, so they're quick enough to move the crossover at the control rate
+  uint16_t crossover = 500 + 3 * kSweep.next(); // 116 to 881 Hz
+  lows.setLinkwitzRileyLowpassHz(crossover);
+  highs.setLinkwitzRileyHighpassHz(crossover);
+}
+
+AudioOutput updateAudio() {
+  int in = aSaw.next() << 5; // the filters work best with 13 to 15 bit signals
+  int low = lows.next(in);
+  int high = (int)(((long)highs.next(in) * tremolo_level) >> 8);
+  return MonoOutput::fromNBit(15, eq.next(low + high));
+}
@@ -0,0 +1,82 @@
+/*  Example of running an effect at half the audio rate,
+    using Mozzi sonification library.
+
+    Demonstrates HalfBandDecimator and HalfBandInterpolator.  The sound is
+    brought down to MOZZI_AUDIO_RATE/2 for a reverb, which then only has
+    to run on every other audio frame, and at half the rate its delay lines
+    also last twice as long for the same RAM.  The reverb is brought back up
+    to MOZZI_AUDIO_RATE to mix with the dry sound, with the filters stopping
+    any aliasing on the way down and images on the way up.
+
+    Circuit: Audio output on digital pin 9 on a Uno or similar, or
+    DAC/A14 on Teensy 3.1, or
+    check the README or http://sensorium.github.io/Mozzi/
+
+   Mozzi documentation/API
+   https://sensorium.github.io/Mozzi/doc/html/index.html
+
+   Mozzi help/discussion/announcements:
+   https://groups.google.com/forum/#!forum/mozzi-users
+
+   Copyright 2012-2024 Tim Barrass and the Mozzi Team
+
+   Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+*/
+
+#include <Mozzi.h>
+#include <Oscil.h>
+#include <tables/saw2048_int8.h>
+#include <tables/envelop2048_uint8.h>
+#include <HalfBandFilter.h>
+#include <FDNReverb.h>
+
+#if IS_AVR()
+#include <tables/halfband7_int16.h>
+HalfBandDecimator <HALFBAND7_NUM_COEFFS> down(HALFBAND7_DATA); // cheapest filters for AVR
+HalfBandInterpolator <HALFBAND7_NUM_COEFFS> up(HALFBAND7_DATA);
+FDNReverb <512> reverb(200, 96);
+#else
+#include <tables/halfband31_int16.h>
+HalfBandDecimator <HALFBAND31_NUM_COEFFS> down(HALFBAND31_DATA);
+HalfBandInterpolator <HALFBAND31_NUM_COEFFS> up(HALFBAND31_DATA);
+FDNReverb <8192, 8> reverb(235, 64); // as long as a 16384 cell reverb at the full rate
+#endif
+
+Oscil <SAW2048_NUM_CELLS, MOZZI_AUDIO_RATE> aSaw(SAW2048_DATA);
+Oscil <ENVELOP2048_NUM_CELLS, MOZZI_AUDIO_RATE> aEnvelop(ENVELOP2048_DATA);
+
+bool odd_frame = false;
+int first_of_pair;
+
+
+void setup(){
+  aSaw.setFreq(110);
+  aEnvelop.setFreq(1.5f);
+  startMozzi();
+}
+
+
+void updateControl(){
+}
+
+
+AudioOutput updateAudio(){
+  int dry = ((int)aSaw.next() * (byte)aEnvelop.next()) >> 2; // 14 bits
+  int wet;
+  if (!odd_frame) {
+    // keep this sample to go down with the next one, and play the second half of the last pair from the reverb
+    first_of_pair = dry;
+    wet = up.second();
+  } else {
+    // the half rate part of the patch, once every two frames
+    int slow = down.next(first_of_pair, dry);
+    wet = up.next(reverb.next(slow));
+  }
+  odd_frame = !odd_frame;
+  return MonoOutput::fromAlmostNBit(15, dry + (wet >> 1));
+}
+
+
+void loop(){
+  audioHook();
+}
@@ -0,0 +1,70 @@
+/*  Example of a bass line through a four pole ladder filter,
+    using Mozzi sonification library.
+
+    Demonstrates LadderFilter, a 24 dB/octave resonant lowpass with
+    saturation in its feedback loop.  Each note starts with the cutoff
+    high and lets it fall, and the resonance is swept slowly so the filter
+    squelches more as it goes on, up to the point where it whistles by itself.
+
+    Circuit: Audio output on digital pin 9 on a Uno or similar, or
+    DAC/A14 on Teensy 3.1, or
+    check the README or http://sensorium.github.io/Mozzi/
+
+   Mozzi documentation/API
+   https://sensorium.github.io/Mozzi/doc/html/index.html
+
+   Mozzi help/discussion/announcements:
+   https://groups.google.com/forum/#!forum/mozzi-users
+
+   Copyright 2012-2024 Tim Barrass and the Mozzi Team
+
+   Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+*/
+
+#include <Mozzi.h>
+#include <Oscil.h>
+#include <tables/saw2048_int8.h>
+#include <tables/cos2048_int8.h> // for resonance modulation
+#include <LadderFilter.h>
+#include <EventDelay.h>
+#include <mozzi_midi.h>
+
+Oscil<SAW2048_NUM_CELLS, MOZZI_AUDIO_RATE> aSaw(SAW2048_DATA);
+Oscil<COS2048_NUM_CELLS, MOZZI_CONTROL_RATE> kResonanceMod(COS2048_DATA);
+EventDelay kNoteDelay;
+
+LadderFilter<LOWPASS> ladder; // 8 bit version for 8 bit input, LadderFilter<LOWPASS, uint16_t> is for 16 bit input
+
+const uint8_t notes[] = {36, 36, 48, 36, 39, 36, 43, 41};
+uint8_t note_index = 0;
+uint16_t cutoff_hz;
+
+
+void setup(){
+  startMozzi();
+  kResonanceMod.setFreq(0.05f);
+  kNoteDelay.set(200);
+}
+
+
+void updateControl(){
+  if (kNoteDelay.ready()){
+    aSaw.setFreq(mtof(notes[note_index]));
+    note_index = (note_index + 1) & 7;
+    cutoff_hz = 3000; // open the filter at the start of each note
+    kNoteDelay.start();
+  }
+  cutoff_hz -= cutoff_hz >> 4; // and let it fall away
+  ladder.setCutoffHz(cutoff_hz + 80);
+  ladder.setResonance(128 + kResonanceMod.next()); // 0 to 255
+}
+
+
+AudioOutput updateAudio(){
+  return MonoOutput::fromNBit(8, ladder.next(aSaw.next()));
+}
+
+
+void loop(){
+  audioHook();
+}
@@ -0,0 +1,65 @@
+/*  Example of an acid-style bassline with a filter swept at audio rate,
+    using Mozzi sonification library.
+
+    Demonstrates ModulatedResonantFilter.
+    Each note starts with the filter wide open and snaps it shut with a
+    fast decay.  The decay is calculated in updateControl(), and
+    setCutoffTarget() ramps the cutoff smoothly between control updates,
+    so the sweep doesn't step audibly even though it is so fast.
+
+    Circuit: Audio output on digital pin 9 on a Uno or similar, or
+    DAC/A14 on Teensy 3.1, or
+    check the README or http://sensorium.github.io/Mozzi/
+
+   Mozzi documentation/API
+   https://sensorium.github.io/Mozzi/doc/html/index.html
+
+   Mozzi help/discussion/announcements:
+   https://groups.google.com/forum/#!forum/mozzi-users
+
+   Copyright 2024 Tim Barrass and the Mozzi Team
+
+   Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+*/
+
+#include <Mozzi.h>
+#include <Oscil.h>
+#include <ResonantFilter.h>
+#include <EventDelay.h>
+#include <mozzi_midi.h>
+#include <mozzi_rand.h>
+#include <tables/saw2048_int8.h>
+
+Oscil<SAW2048_NUM_CELLS, MOZZI_AUDIO_RATE> aSaw(SAW2048_DATA);
+ModulatedResonantFilter<LOWPASS> lpf;
+EventDelay kNoteDelay;
+
+const uint8_t notes[] = {36, 36, 48, 36, 39, 36, 46, 43};
+uint8_t step = 0;
+uint8_t sweep = 0; // decays after each note
+const uint16_t AUDIO_STEPS_PER_CONTROL = MOZZI_AUDIO_RATE / MOZZI_CONTROL_RATE;
+
+void setup() {
+  lpf.setCutoffFreqAndResonance(20, 235);
+  kNoteDelay.set(150);
+  startMozzi();
+}
+
+void updateControl() {
+  if (kNoteDelay.ready()) {
+    aSaw.setFreq(mtof(notes[step]));
+    step = (step + 1) & 7;
+    sweep = 150 + rand(80); // open the filter for the new note
+    kNoteDelay.start();
+  }
+  sweep -= sweep >> 3; // fast exponential decay
+  lpf.setCutoffTarget(15 + sweep, AUDIO_STEPS_PER_CONTROL);
+}
+
+AudioOutput updateAudio() {
+  return MonoOutput::fromNBit(9, lpf.next(aSaw.next())).clip();
+}
+
+void loop() {
+  audioHook();
+}
@@ -0,0 +1,68 @@
+/*  Example of a resonant filter swept right up to the top of the audio range,
+    using Mozzi sonification library.
+
+    Demonstrates StateVariableOversampled(), which runs its filter loop twice
+    per sample so it stays in tune up to nearly MOZZI_AUDIO_RATE/2, and soft
+    clips its resonance so a loud input at a very resonant setting squelches
+    instead of wrapping around.
+
+    On a 16 kHz AVR the extra time may be too much alongside other sounds,
+    and the sketch shows how to opt out.
+
+    Circuit: Audio output on digital pin 9 on a Uno or similar, or
+    DAC/A14 on Teensy 3.1, or
+    check the README or http://sensorium.github.io/Mozzi/
+
+   Mozzi documentation/API
+   https://sensorium.github.io/Mozzi/doc/html/index.html
+
+   Mozzi help/discussion/announcements:
+   https://groups.google.com/forum/#!forum/mozzi-users
+
+   Copyright 2012-2024 Tim Barrass and the Mozzi Team
+
+   Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+*/
+
+#include <Mozzi.h>
+#include <Oscil.h>
+#include <tables/saw2048_int8.h>
+#include <tables/cos2048_int8.h> // for filter modulation
+#include <StateVariable.h>
+
+Oscil<SAW2048_NUM_CELLS, MOZZI_AUDIO_RATE> aSaw(SAW2048_DATA);
+Oscil<COS2048_NUM_CELLS, MOZZI_CONTROL_RATE> kFilterMod(COS2048_DATA);
+
+#if IS_AVR()
+// no oversampling or saturation, to save time on slow boards: the cutoff then reaches about MOZZI_AUDIO_RATE/5
+StateVariableOversampled <LOWPASS, 1, false> svf;
+const uint8_t INPUT_SHIFT = 4; // quieter, as without saturation the resonant peak could wrap around
+#else
+StateVariableOversampled <LOWPASS> svf; // 2x oversampling with saturation
+const uint8_t INPUT_SHIFT = 7; // loud on purpose, the saturation holds the resonant peak
+#endif
+
+
+void setup(){
+  startMozzi();
+  aSaw.setFreq(55);
+  kFilterMod.setFreq(0.2f);
+  svf.setResonance(8); // very resonant
+}
+
+
+void updateControl(){
+  // sweep the cutoff from 100 Hz up to 3/8 of the audio rate, on a squared curve so it spends longer low down
+  uint16_t sweep = (uint16_t)(128 + kFilterMod.next()); // 0 to 255
+  svf.setCentreFreqHz(100 + (uint16_t)(((uint32_t)sweep * sweep * (3 * MOZZI_AUDIO_RATE / 8 - 100)) >> 16));
+}
+
+
+AudioOutput updateAudio(){
+  return MonoOutput::fromAlmostNBit(15, svf.next(aSaw.next() << INPUT_SHIFT));
+}
+
+
+void loop(){
+  audioHook();
+}
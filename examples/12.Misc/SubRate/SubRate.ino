@@ -0,0 +1,92 @@
+/*  Example of running the low parts of a patch at a fraction of the audio rate,
+    using Mozzi sonification library.
+
+    Demonstrates SubRate.  A sub-bass and a filtered drone don't need the whole
+    audio rate, so each goes in its own update function which Mozzi calls only
+    every 4th or 2nd audio frame, staggered so they don't land on the same frame.
+    Their Oscils are made for the lower rates, and SubRate joins their samples
+    back up at MOZZI_AUDIO_RATE for updateAudio() to mix with the lead, which
+    runs at the full rate as usual.
+
+    Circuit: Audio output on digital pin 9 on a Uno or similar, or
+    DAC/A14 on Teensy 3.1, or
+    check the README or http://sensorium.github.io/Mozzi/
+
+   Mozzi documentation/API
+   https://sensorium.github.io/Mozzi/doc/html/index.html
+
+   Mozzi help/discussion/announcements:
+   https://groups.google.com/forum/#!forum/mozzi-users
+
+   Copyright 2012-2024 Tim Barrass and the Mozzi Team
+
+   Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+*/
+
+#include <Mozzi.h>
+#include <Oscil.h>
+#include <tables/sin2048_int8.h>
+#include <tables/saw2048_int8.h>
+#include <tables/triangle2048_int8.h>
+#include <ResonantFilter.h>
+#include <SubRate.h>
+#include <mozzi_midi.h>
+
+// the lead runs at the full audio rate
+Oscil <TRIANGLE2048_NUM_CELLS, MOZZI_AUDIO_RATE> aLead(TRIANGLE2048_DATA);
+
+// the sub-bass at a quarter
+Oscil <SIN2048_NUM_CELLS, MOZZI_AUDIO_RATE/4> aSub(SIN2048_DATA);
+
+// and the drone at half, with its filter
+Oscil <SAW2048_NUM_CELLS, MOZZI_AUDIO_RATE/2> aDrone1(SAW2048_DATA);
+Oscil <SAW2048_NUM_CELLS, MOZZI_AUDIO_RATE/2> aDrone2(SAW2048_DATA);
+LowPassFilter lpf;
+
+Oscil <SIN2048_NUM_CELLS, MOZZI_CONTROL_RATE> kFilterMod(SIN2048_DATA);
+
+
+int updateSubBass(){
+  return aSub.next() << 6;
+}
+
+int updateDrone(){
+  return lpf.next((aDrone1.next() + aDrone2.next()) >> 1) << 5;
+}
+
+SubRate <4> subBass(updateSubBass);
+SubRate <2> drone(updateDrone);
+
+const uint8_t notes[] = {64, 67, 71, 72, 71, 67};
+uint8_t note_index = 0;
+uint8_t control_count = 0;
+
+
+void setup(){
+  aSub.setFreq(mtof(28));
+  aDrone1.setFreq(mtof(40));
+  aDrone2.setFreq(mtof(40) * 1.006f);
+  kFilterMod.setFreq(0.1f);
+  startMozzi();
+}
+
+
+void updateControl(){
+  if (++control_count == MOZZI_CONTROL_RATE / 4) {
+    control_count = 0;
+    aLead.setFreq(mtof(notes[note_index]));
+    if (++note_index == sizeof(notes)) note_index = 0;
+  }
+  // the filter's cutoff is worked out for the full audio rate, so at half the rate it's an octave lower
+  lpf.setCutoffFreqAndResonance(80 + (kFilterMod.next() >> 2), 200);
+}
+
+
+AudioOutput updateAudio(){
+  return MonoOutput::fromAlmostNBit(15, ((int)aLead.next() << 5) + subBass.next() + drone.next());
+}
+
+
+void loop(){
+  audioHook();
+}
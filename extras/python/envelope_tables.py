@@ -0,0 +1,35 @@
+## generates the tables used by ADSR for its curved segments
+## expcurve257_uint16: (1 - exp(-5x)) / (1 - exp(-5)) for x from 0 to 1, as Q1n15
+## eadpole256_uint32: thresholds for Ead to find its Q8n8 1-pole from update rate * milliseconds, without floats
+
+
+import os
+import textwrap
+import math
+
+def write(outfile, tablename, tabletype, tablelength, values, comment):
+    fout = open(os.path.expanduser(outfile), "w")
+    fout.write('#ifndef ' + tablename + '_H_' + '\n')
+    fout.write('#define ' + tablename + '_H_' + '\n\n')
+    fout.write('#include <Arduino.h>'+'\n')
+    fout.write('#include "mozzi_pgmspace.h"'+'\n\n')
+    fout.write('/* ' + comment + '\n*/\n\n')
+    fout.write('#define ' + tablename + '_NUM_CELLS '+ str(tablelength)+'\n\n')
+    outstring = 'CONSTTABLE_STORAGE(' + tabletype + ') ' + tablename + '_DATA [] = {'
+    outstring += ', '.join(str(v) for v in values)
+    outstring = textwrap.fill(outstring, 80)
+    outstring += '\n };\n\n#endif /* ' + tablename + '_H_ */\n'
+    fout.write(outstring)
+    fout.close()
+    print("wrote " + outfile)
+
+write("expcurve257_uint16.h", "EXPCURVE257", "uint16_t", 257,
+      [int(round((1 - math.exp(-5.0*i/256))/(1 - math.exp(-5.0))*32768)) for i in range(257)],
+      "(1 - exp(-5x)) / (1 - exp(-5)) for x from 0 to 1 in 256 steps (plus one for interpolation), as Q1n15.\nThe shape of an exponential envelope segment, which moves quickly at first and slows down as it nears its target, reaching it at x = 1.")
+
+# Ead's 1-pole for a time of t updates is 1 - 0.001^(1/t), and t = update rate * ms / 1000,
+# so as Q8n8, rounded down, it's at most v for update rate * ms >= the threshold for v
+NUMERATOR = -1000*math.log(0.001)
+write("eadpole256_uint32.h", "EADPOLE256", "uint32_t", 256,
+      [int(math.floor(NUMERATOR / -math.log(1 - (v+1)/256.0))) + 1 if v < 255 else 1 for v in range(256)],
+      "The smallest update rate * milliseconds for which Ead's 1-pole, 1 - 0.001^(1000 / (update rate * milliseconds)), is at most v as Q8n8, for v from 0 to 255.\nThe pole for a time is the first v whose threshold it reaches, or 256 for a time of 0.")
@@ -0,0 +1,61 @@
+## generates the tables used by ResonantFilter::setCutoffHz() and StateVariable::setCentreFreqHz() and setResonance()
+## twosinpi257_uint16: 2*sin(pi*x) for x from 0 to 0.25 (cutoff/sample rate), as Q1n15
+## sqrt256_uint8: sqrt(x) for x from 0 to 255/256, as Q0n8
+## svftuning256_uint16: 1/sqrt(x) for x from 0 to 255/256, as Q2n14, to tune StateVariable for its resonance
+## tanh65_uint16: tanh(x) for x from 0 to 4, as Q0n15, for the saturation in LadderFilter
+## laddertuning257_uint16: LadderFilter's one pole coefficient which puts its resonance at x from 0 to 0.25 (cutoff/sample rate), as Q0n16
+
+
+import os
+import textwrap
+import math
+import cmath
+
+def write(outfile, tablename, tabletype, tablelength, values, comment):
+    fout = open(os.path.expanduser(outfile), "w")
+    fout.write('#ifndef ' + tablename + '_H_' + '\n')
+    fout.write('#define ' + tablename + '_H_' + '\n\n')
+    fout.write('#include <Arduino.h>'+'\n')
+    fout.write('#include "mozzi_pgmspace.h"'+'\n\n')
+    fout.write('/* ' + comment + '\n*/\n\n')
+    fout.write('#define ' + tablename + '_NUM_CELLS '+ str(tablelength)+'\n\n')
+    outstring = 'CONSTTABLE_STORAGE(' + tabletype + ') ' + tablename + '_DATA [] = {'
+    outstring += ', '.join(str(v) for v in values)
+    outstring = textwrap.fill(outstring, 80)
+    outstring += '\n };\n\n#endif /* ' + tablename + '_H_ */\n'
+    fout.write(outstring)
+    fout.close()
+    print("wrote " + outfile)
+
+write("twosinpi257_uint16.h", "TWOSINPI257", "uint16_t", 257,
+      [int(round(2*math.sin(math.pi*0.25*i/256)*32768)) for i in range(257)],
+      "2*sin(pi*x) for x from 0 to 0.25 in 256 steps (plus one for interpolation), as Q1n15.\nx is a filter's cutoff frequency divided by the sample rate.")
+write("sqrt256_uint8.h", "SQRT256", "uint8_t", 256,
+      [int(math.sqrt(i*256)) for i in range(256)],
+      "sqrt(x) for x from 0 to 255/256, as Q0n8 (both in and out), rounded down.")
+write("svftuning256_uint16.h", "SVFTUNING256", "uint16_t", 256,
+      [min(65535, int(round((max(i, 1)/256.0)**-0.5*16384))) for i in range(256)],
+      "1/sqrt(x) for x from 0 to 255/256, as Q2n14, limited to 65535.\nStateVariable scales its feedback by scale (sqrt(q)), which lowers its centre frequency by sqrt(scale), so this undoes that.")
+write("tanh65_uint16.h", "TANH65", "uint16_t", 65,
+      [min(32767, int(round(math.tanh(4.0*i/64)*32768))) for i in range(65)],
+      "tanh(x) for x from 0 to 4 in 64 steps (plus one for interpolation), as Q0n15, limited to 32767.\ntanh is odd, so only the positive half is needed.")
+
+def ladder_coeff(x):
+    # the coefficient g which gives a loop phase of -pi at w: four one poles g/(1-(1-g)/z),
+    # and one and a half samples of delay from feeding back the average of the last two outputs
+    w = 2*math.pi*x
+    if w == 0:
+        return 0
+    lo, hi = 0.0, 1.0
+    for _ in range(60):
+        g = (lo+hi)/2
+        phase = 4*cmath.phase(g/(1-(1-g)*cmath.exp(-1j*w))) - 1.5*w
+        if phase < -math.pi:
+            lo = g
+        else:
+            hi = g
+    return g
+
+write("laddertuning257_uint16.h", "LADDERTUNING257", "uint16_t", 257,
+      [int(round(ladder_coeff(0.25*i/256)*65536)) for i in range(257)],
+      "The one pole coefficient for LadderFilter, which puts its resonant peak at x from 0 to 0.25 in 256 steps (plus one for interpolation), as Q0n16.\nx is the cutoff frequency divided by the sample rate.")
@@ -0,0 +1,54 @@
+## generates the half-band lowpass FIR coefficients used by HalfBandDecimator and HalfBandInterpolator
+## A half-band filter of 4*K-1 taps has a centre tap of 0.5, and every other tap zero, so only
+## the K taps to one side of the centre, at odd distances 1, 3, 5... from it, need storing.
+## They are Kaiser windowed sincs, as Q15 (int16_t), with the sum made exactly right so the gain at 0 Hz is 1.
+## Each filter passes up to the frequency given (within 1%) and is reduced by the attenuation above (the sample rate)/2 minus that frequency.
+## Run from the tables directory: python ../extras/python/halfband_fir.py
+
+import os
+import textwrap
+import math
+
+def i0(x):
+    # modified Bessel function of the first kind, order 0, for the Kaiser window
+    total = term = 1.0
+    for k in range(1, 40):
+        term *= (x/2/k)**2
+        total += term
+    return total
+
+def design(num_coeffs, beta):
+    half_length = 2*num_coeffs
+    coeffs = []
+    for i in range(num_coeffs):
+        n = 2*i + 1
+        window = i0(beta*math.sqrt(1 - (n/half_length)**2))/i0(beta)
+        coeffs.append(math.sin(math.pi*n/2)/(math.pi*n)*window)
+    scale = 0.25/sum(coeffs) # 0.5 from the centre tap, and the taps come in pairs
+    quantised = [int(round(c*scale*32768)) for c in coeffs]
+    quantised[0] += 8192 - sum(quantised)
+    return quantised
+
+def write(outfile, tablename, num_coeffs, beta, comment):
+    values = design(num_coeffs, beta)
+    fout = open(os.path.expanduser(outfile), "w")
+    fout.write('#ifndef ' + tablename + '_H_' + '\n')
+    fout.write('#define ' + tablename + '_H_' + '\n\n')
+    fout.write('#include <Arduino.h>'+'\n')
+    fout.write('#include "mozzi_pgmspace.h"'+'\n\n')
+    fout.write('/* ' + comment + '\n*/\n\n')
+    fout.write('#define ' + tablename + '_NUM_COEFFS '+ str(num_coeffs)+'\n\n')
+    outstring = 'CONSTTABLE_STORAGE(int16_t) ' + tablename + '_DATA [] = {'
+    outstring += ', '.join(str(v) for v in values)
+    outstring = textwrap.fill(outstring, 80)
+    outstring += '\n };\n\n#endif /* ' + tablename + '_H_ */\n'
+    fout.write(outstring)
+    fout.close()
+    print("wrote " + outfile)
+
+write("halfband7_int16.h", "HALFBAND7", 2, 3,
+      "7 tap half-band lowpass, passing up to 0.05 of the sample rate, 25 dB down above 0.35.\nThe cheapest, for AVR.")
+write("halfband15_int16.h", "HALFBAND15", 4, 5,
+      "15 tap half-band lowpass, passing up to 0.16 of the sample rate, 40 dB down above 0.34 and 53 dB above 0.35.")
+write("halfband31_int16.h", "HALFBAND31", 8, 8,
+      "31 tap half-band lowpass, passing up to 0.19 of the sample rate, 40 dB down above 0.31 and 80 dB above 0.35.")
@@ -14,6 +14,7 @@
 #include "CircularBuffer.h"
 #include "mozzi_analog.h"
 #include "internal/mozzi_rand_p.h"
+#include "internal/subrate_p.h"
 #include "AudioOutput.h"
 
 /** @brief Internal. Do not use function in this namespace in your sketch!
@@ -233,6 +234,7 @@ void audioHook() // 2us on AVR excluding updateAudio()
 // setPin13High();
   if (canBufferAudioOutput()) {
     advanceControlLoop();
+    SubRatePrivate::advance(); // any SubRate update functions due this frame
     bufferAudioOutput(updateAudio());
 
 #if defined(LOOP_YIELD)
@@ -284,6 +286,10 @@ uint32_t MozziRandPrivate::x=132456789;
 uint32_t MozziRandPrivate::y=362436069;
 uint32_t MozziRandPrivate::z=521288629;
 
+SubRateNode * SubRatePrivate::list = nullptr;
+uint8_t SubRatePrivate::load[SubRatePrivate::MAX_DIVIDER];
+uint8_t SubRatePrivate::frame = 0;
+
 ////// END initialization ///////
 }
 
@@ -0,0 +1,84 @@
+/*
+ * subrate_p.h
+ *
+ * This file is part of Mozzi.
+ *
+ * Copyright 2012-2024 Tim Barrass and the Mozzi Team
+ *
+ * Mozzi is licensed under the GNU Lesser General Public Licence (LGPL) Version 2.1 or later.
+ *
+*/
+
+#ifndef SUBRATE_P_H
+#define SUBRATE_P_H
+
+namespace MozziPrivate {
+
+/* The part of SubRate which the scheduler in audioHook() sees: a linked list of update functions,
+each with the frames it runs on, and the interpolation between the samples they give. */
+class SubRateNode {
+friend class SubRatePrivate;
+protected:
+  SubRateNode * next_node;
+  int (*update)();
+  int32_t value, step; // interpolated output, with 8 fractional bits
+  int target;
+  uint8_t mask, shift, phase;
+
+  // run the update function, and interpolate from the last sample to the new one over the next frames
+  inline void tick() {
+    int sample = update();
+    value = (int32_t) target << 8;
+    step = (((int32_t) sample - target) << 8) >> shift;
+    target = sample;
+  }
+};
+
+class SubRatePrivate {
+  static const uint8_t MAX_DIVIDER = 8;
+  static SubRateNode * list;
+  static uint8_t load[MAX_DIVIDER]; // how many updates run on each frame of 8
+  static uint8_t frame;
+public:
+  // put the node in the list, on the frames which have the fewest updates already
+  static void add(SubRateNode * node) {
+    uint8_t divider = node->mask + 1;
+    uint8_t best_phase = 0, best_peak = 255;
+    for (uint8_t p = 0; p < divider; ++p) {
+      uint8_t peak = 0;
+      for (uint8_t f = p; f < MAX_DIVIDER; f += divider) {
+        if (load[f] > peak) peak = load[f];
+      }
+      if (peak < best_peak) {
+        best_peak = peak;
+        best_phase = p;
+      }
+    }
+    for (uint8_t f = best_phase; f < MAX_DIVIDER; f += divider) ++load[f];
+    node->phase = best_phase;
+    node->next_node = list;
+    list = node;
+  }
+
+  static void remove(SubRateNode * node) {
+    for (SubRateNode ** n = &list; *n; n = &(*n)->next_node) {
+      if (*n == node) {
+        *n = node->next_node;
+        for (uint8_t f = node->phase; f < MAX_DIVIDER; f += node->mask + 1) --load[f];
+        return;
+      }
+    }
+  }
+
+  // called by audioHook() before every updateAudio()
+  static inline void advance() {
+    ++frame;
+    for (SubRateNode * n = list; n; n = n->next_node) {
+      if (((uint8_t) (frame - n->phase) & n->mask) == 0) n->tick();
+    }
+  }
+};
+
+}
+
+#endif
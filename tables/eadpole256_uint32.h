@@ -0,0 +1,38 @@
+#ifndef EADPOLE256_H_
+#define EADPOLE256_H_
+
+#include <Arduino.h>
+#include "mozzi_pgmspace.h"
+
+/* The smallest update rate * milliseconds for which Ead's 1-pole, 1 - 0.001^(1000 / (update rate * milliseconds)), is at most v as Q8n8, for v from 0 to 255.
+The pole for a time is the first v whose threshold it reaches, or 256 for a time of 0.
+*/
+
+#define EADPOLE256_NUM_CELLS 256
+
+CONSTTABLE_STORAGE(uint32_t) EADPOLE256_DATA [] = {1764930, 880735, 586002,
+438634, 350212, 291264, 249157, 217577, 193013, 173362, 157284, 143884, 132546,
+122827, 114404, 107034, 100530, 94748, 89575, 84919, 80706, 76876, 73379, 70173,
+67223, 64500, 61978, 59637, 57456, 55421, 53517, 51732, 50055, 48476, 46987,
+45581, 44251, 42991, 41795, 40659, 39578, 38548, 37566, 36629, 35733, 34876,
+34055, 33269, 32514, 31789, 31093, 30423, 29779, 29158, 28560, 27983, 27426,
+26888, 26369, 25866, 25380, 24910, 24454, 24012, 23584, 23169, 22766, 22375,
+21995, 21626, 21267, 20918, 20578, 20248, 19926, 19613, 19307, 19010, 18719,
+18436, 18160, 17891, 17627, 17371, 17120, 16874, 16635, 16400, 16171, 15947,
+15727, 15513, 15303, 15097, 14895, 14698, 14504, 14315, 14129, 13947, 13768,
+13592, 13420, 13252, 13086, 12923, 12764, 12607, 12453, 12301, 12153, 12006,
+11863, 11721, 11583, 11446, 11312, 11179, 11049, 10921, 10796, 10672, 10549,
+10429, 10311, 10194, 10079, 9966, 9855, 9745, 9637, 9530, 9425, 9321, 9218,
+9117, 9018, 8920, 8823, 8727, 8633, 8539, 8447, 8357, 8267, 8178, 8091, 8004,
+7919, 7835, 7751, 7669, 7588, 7507, 7428, 7349, 7271, 7195, 7118, 7043, 6969,
+6895, 6822, 6750, 6679, 6608, 6539, 6469, 6401, 6333, 6266, 6199, 6133, 6068,
+6003, 5939, 5876, 5813, 5750, 5688, 5627, 5566, 5506, 5446, 5387, 5328, 5269,
+5211, 5154, 5097, 5040, 4983, 4927, 4872, 4817, 4762, 4707, 4653, 4599, 4546,
+4492, 4439, 4387, 4334, 4282, 4230, 4179, 4127, 4076, 4025, 3974, 3923, 3873,
+3822, 3772, 3722, 3672, 3622, 3572, 3522, 3472, 3422, 3372, 3322, 3272, 3222,
+3172, 3122, 3072, 3021, 2970, 2919, 2867, 2815, 2763, 2710, 2657, 2602, 2548,
+2492, 2435, 2377, 2318, 2258, 2195, 2131, 2064, 1994, 1920, 1841, 1756, 1661,
+1554, 1424, 1246, 1
+ };
+
+#endif /* EADPOLE256_H_ */
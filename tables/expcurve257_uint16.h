@@ -0,0 +1,39 @@
+#ifndef EXPCURVE257_H_
+#define EXPCURVE257_H_
+
+#include <Arduino.h>
+#include "mozzi_pgmspace.h"
+
+/* (1 - exp(-5x)) / (1 - exp(-5)) for x from 0 to 1 in 256 steps (plus one for interpolation), as Q1n15.
+The shape of an exponential envelope segment, which moves quickly at first and slows down as it nears its target, reaching it at x = 1.
+*/
+
+#define EXPCURVE257_NUM_CELLS 257
+
+CONSTTABLE_STORAGE(uint16_t) EXPCURVE257_DATA [] = {0, 638, 1264, 1877, 2479,
+3069, 3648, 4216, 4772, 5318, 5853, 6378, 6893, 7398, 7893, 8378, 8854, 9321,
+9779, 10228, 10668, 11100, 11523, 11938, 12345, 12745, 13136, 13520, 13897,
+14266, 14628, 14984, 15332, 15673, 16008, 16337, 16659, 16975, 17285, 17588,
+17886, 18178, 18465, 18746, 19021, 19292, 19556, 19816, 20071, 20321, 20566,
+20806, 21042, 21273, 21500, 21722, 21940, 22154, 22363, 22569, 22770, 22968,
+23162, 23352, 23538, 23721, 23901, 24076, 24249, 24418, 24584, 24746, 24906,
+25062, 25215, 25366, 25513, 25658, 25800, 25939, 26075, 26209, 26340, 26469,
+26595, 26719, 26840, 26959, 27075, 27190, 27302, 27412, 27520, 27626, 27730,
+27831, 27931, 28029, 28125, 28219, 28311, 28402, 28491, 28578, 28663, 28747,
+28829, 28909, 28988, 29066, 29141, 29216, 29289, 29360, 29431, 29500, 29567,
+29633, 29698, 29762, 29824, 29886, 29946, 30004, 30062, 30119, 30174, 30229,
+30282, 30335, 30386, 30436, 30486, 30534, 30582, 30628, 30674, 30719, 30763,
+30806, 30848, 30890, 30930, 30970, 31009, 31047, 31085, 31122, 31158, 31193,
+31228, 31262, 31296, 31328, 31361, 31392, 31423, 31453, 31483, 31512, 31541,
+31569, 31596, 31623, 31650, 31676, 31701, 31726, 31750, 31774, 31798, 31821,
+31844, 31866, 31888, 31909, 31930, 31950, 31970, 31990, 32010, 32028, 32047,
+32065, 32083, 32101, 32118, 32135, 32151, 32168, 32184, 32199, 32214, 32229,
+32244, 32259, 32273, 32287, 32300, 32314, 32327, 32339, 32352, 32364, 32377,
+32388, 32400, 32411, 32423, 32434, 32444, 32455, 32465, 32475, 32485, 32495,
+32505, 32514, 32523, 32532, 32541, 32550, 32558, 32567, 32575, 32583, 32591,
+32599, 32606, 32614, 32621, 32628, 32635, 32642, 32649, 32655, 32662, 32668,
+32674, 32680, 32686, 32692, 32698, 32704, 32709, 32715, 32720, 32725, 32730,
+32735, 32740, 32745, 32750, 32755, 32759, 32764, 32768
+ };
+
+#endif /* EXPCURVE257_H_ */
@@ -0,0 +1,15 @@
+#ifndef HALFBAND15_H_
+#define HALFBAND15_H_
+
+#include <Arduino.h>
+#include "mozzi_pgmspace.h"
+
+/* 15 tap half-band lowpass, passing up to 0.16 of the sample rate, 40 dB down above 0.34 and 53 dB above 0.35.
+*/
+
+#define HALFBAND15_NUM_COEFFS 4
+
+CONSTTABLE_STORAGE(int16_t) HALFBAND15_DATA [] = {10081, -2516, 797, -170
+ };
+
+#endif /* HALFBAND15_H_ */
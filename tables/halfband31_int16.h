@@ -0,0 +1,16 @@
+#ifndef HALFBAND31_H_
+#define HALFBAND31_H_
+
+#include <Arduino.h>
+#include "mozzi_pgmspace.h"
+
+/* 31 tap half-band lowpass, passing up to 0.19 of the sample rate, 40 dB down above 0.31 and 80 dB above 0.35.
+*/
+
+#define HALFBAND31_NUM_COEFFS 8
+
+CONSTTABLE_STORAGE(int16_t) HALFBAND31_DATA [] = {10279, -3045, 1435, -703, 320,
+-125, 38, -7
+ };
+
+#endif /* HALFBAND31_H_ */
@@ -0,0 +1,16 @@
+#ifndef HALFBAND7_H_
+#define HALFBAND7_H_
+
+#include <Arduino.h>
+#include "mozzi_pgmspace.h"
+
+/* 7 tap half-band lowpass, passing up to 0.05 of the sample rate, 25 dB down above 0.35.
+The cheapest, for AVR.
+*/
+
+#define HALFBAND7_NUM_COEFFS 2
+
+CONSTTABLE_STORAGE(int16_t) HALFBAND7_DATA [] = {9826, -1634
+ };
+
+#endif /* HALFBAND7_H_ */
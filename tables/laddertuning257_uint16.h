@@ -0,0 +1,39 @@
+#ifndef LADDERTUNING257_H_
+#define LADDERTUNING257_H_
+
+#include <Arduino.h>
+#include "mozzi_pgmspace.h"
+
+/* The one pole coefficient for LadderFilter, which puts its resonant peak at x from 0 to 0.25 in 256 steps (plus one for interpolation), as Q0n16.
+x is the cutoff frequency divided by the sample rate.
+*/
+
+#define LADDERTUNING257_NUM_CELLS 257
+
+CONSTTABLE_STORAGE(uint16_t) LADDERTUNING257_DATA [] = {0, 400, 797, 1190, 1579,
+1965, 2348, 2727, 3103, 3476, 3845, 4211, 4574, 4934, 5291, 5645, 5996, 6344,
+6689, 7031, 7370, 7707, 8041, 8372, 8700, 9026, 9350, 9670, 9989, 10304, 10618,
+10929, 11237, 11543, 11847, 12149, 12448, 12745, 13040, 13333, 13623, 13912,
+14198, 14482, 14765, 15045, 15323, 15600, 15874, 16146, 16417, 16686, 16953,
+17218, 17481, 17743, 18003, 18261, 18517, 18772, 19025, 19276, 19526, 19774,
+20021, 20266, 20509, 20751, 20992, 21231, 21468, 21704, 21939, 22172, 22404,
+22635, 22864, 23092, 23318, 23543, 23767, 23990, 24211, 24431, 24650, 24867,
+25084, 25299, 25513, 25726, 25937, 26148, 26357, 26566, 26773, 26979, 27184,
+27388, 27591, 27793, 27994, 28194, 28393, 28591, 28788, 28984, 29179, 29373,
+29566, 29759, 29950, 30140, 30330, 30519, 30707, 30894, 31080, 31265, 31450,
+31634, 31817, 31999, 32180, 32361, 32540, 32720, 32898, 33076, 33252, 33429,
+33604, 33779, 33953, 34126, 34299, 34471, 34643, 34813, 34983, 35153, 35322,
+35490, 35658, 35825, 35991, 36157, 36323, 36487, 36652, 36815, 36978, 37141,
+37303, 37465, 37626, 37786, 37946, 38106, 38265, 38423, 38581, 38739, 38896,
+39053, 39209, 39365, 39520, 39675, 39830, 39984, 40138, 40291, 40444, 40597,
+40749, 40901, 41052, 41203, 41354, 41504, 41655, 41804, 41954, 42103, 42252,
+42400, 42548, 42696, 42844, 42991, 43138, 43285, 43431, 43577, 43723, 43869,
+44014, 44159, 44304, 44449, 44594, 44738, 44882, 45026, 45169, 45313, 45456,
+45599, 45742, 45885, 46028, 46170, 46312, 46454, 46596, 46738, 46880, 47021,
+47163, 47304, 47445, 47587, 47728, 47868, 48009, 48150, 48291, 48431, 48572,
+48712, 48853, 48993, 49133, 49273, 49414, 49554, 49694, 49834, 49974, 50114,
+50254, 50394, 50535, 50675, 50815, 50955, 51095, 51235, 51376, 51516, 51656,
+51797, 51937, 52078, 52219, 52359, 52500
+ };
+
+#endif /* LADDERTUNING257_H_ */
@@ -0,0 +1,39 @@
+#ifndef SVFTUNING256_H_
+#define SVFTUNING256_H_
+
+#include <Arduino.h>
+#include "mozzi_pgmspace.h"
+
+/* 1/sqrt(x) for x from 0 to 255/256, as Q2n14, limited to 65535.
+StateVariable scales its feedback by scale (sqrt(q)), which lowers its centre frequency by sqrt(scale), so this undoes that.
+*/
+
+#define SVFTUNING256_NUM_CELLS 256
+
+CONSTTABLE_STORAGE(uint16_t) SVFTUNING256_DATA [] = {65535, 65535, 65535, 65535,
+65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535,
+65535, 65535, 63579, 61788, 60140, 58617, 57205, 55889, 54661, 53510, 52429,
+51411, 50450, 49541, 48679, 47861, 47082, 46341, 45633, 44957, 44310, 43691,
+43096, 42525, 41977, 41449, 40940, 40450, 39977, 39520, 39078, 38651, 38238,
+37837, 37449, 37073, 36708, 36353, 36008, 35673, 35347, 35030, 34722, 34421,
+34128, 33843, 33564, 33292, 33027, 32768, 32515, 32268, 32026, 31790, 31558,
+31332, 31111, 30894, 30682, 30474, 30270, 30070, 29874, 29682, 29494, 29309,
+29127, 28949, 28774, 28602, 28434, 28268, 28105, 27945, 27787, 27632, 27480,
+27330, 27183, 27038, 26895, 26755, 26617, 26481, 26346, 26214, 26084, 25956,
+25830, 25705, 25583, 25462, 25342, 25225, 25109, 24994, 24882, 24770, 24660,
+24552, 24445, 24339, 24235, 24132, 24031, 23930, 23831, 23733, 23637, 23541,
+23447, 23354, 23262, 23170, 23080, 22992, 22904, 22817, 22731, 22646, 22562,
+22479, 22396, 22315, 22235, 22155, 22077, 21999, 21922, 21845, 21770, 21695,
+21621, 21548, 21476, 21404, 21333, 21263, 21193, 21124, 21056, 20988, 20921,
+20855, 20789, 20724, 20660, 20596, 20533, 20470, 20408, 20346, 20285, 20225,
+20165, 20106, 20047, 19988, 19930, 19873, 19816, 19760, 19704, 19649, 19594,
+19539, 19485, 19431, 19378, 19326, 19273, 19221, 19170, 19119, 19068, 19018,
+18968, 18919, 18870, 18821, 18773, 18725, 18677, 18630, 18583, 18536, 18490,
+18444, 18399, 18354, 18309, 18264, 18220, 18176, 18133, 18090, 18047, 18004,
+17962, 17920, 17878, 17837, 17795, 17755, 17714, 17674, 17634, 17594, 17554,
+17515, 17476, 17438, 17399, 17361, 17323, 17285, 17248, 17211, 17174, 17137,
+17100, 17064, 17028, 16992, 16957, 16921, 16886, 16851, 16817, 16782, 16748,
+16714, 16680, 16646, 16613, 16579, 16546, 16514, 16481, 16448, 16416
+ };
+
+#endif /* SVFTUNING256_H_ */
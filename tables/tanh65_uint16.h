@@ -0,0 +1,22 @@
+#ifndef TANH65_H_
+#define TANH65_H_
+
+#include <Arduino.h>
+#include "mozzi_pgmspace.h"
+
+/* tanh(x) for x from 0 to 4 in 64 steps (plus one for interpolation), as Q0n15, limited to 32767.
+tanh is odd, so only the positive half is needed.
+*/
+
+#define TANH65_NUM_CELLS 65
+
+CONSTTABLE_STORAGE(uint16_t) TANH65_DATA [] = {0, 2045, 4075, 6073, 8025, 9919,
+11743, 13486, 15143, 16706, 18173, 19542, 20813, 21986, 23066, 24054, 24956,
+25776, 26519, 27191, 27797, 28341, 28830, 29268, 29660, 30010, 30322, 30600,
+30847, 31067, 31262, 31435, 31589, 31726, 31846, 31953, 32048, 32132, 32206,
+32271, 32329, 32381, 32426, 32466, 32501, 32532, 32560, 32584, 32606, 32625,
+32642, 32657, 32670, 32681, 32691, 32700, 32708, 32715, 32721, 32727, 32732,
+32736, 32740, 32743, 32746
+ };
+
+#endif /* TANH65_H_ */